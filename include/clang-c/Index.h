@@ -32,7 +32,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 50
+#define CINDEX_VERSION_MINOR 51
 
 #define CINDEX_VERSION_ENCODE(major, minor) ( \
       ((major) * 10000)                       \
@@ -4135,6 +4135,54 @@ CINDEX_LINKAGE unsigned clang_visitChildrenWithBlock(CXCursor parent,
 #  endif
 #endif
 
+/**
+ * A list of cursors produced by a single traversal, for clients that
+ * extract cursors in bulk rather than visiting them one callback at a
+ * time.
+ */
+typedef struct {
+  /** The number of cursors in the \c cursors array. */
+  unsigned count;
+  /** An array of \c count cursors. */
+  CXCursor *cursors;
+} CXCursorList;
+
+/**
+ * Collect descendants of a cursor into a list with a single call.
+ *
+ * This performs the same traversal as \c clang_visitChildren() with a
+ * visitor that returns \c CXChildVisit_Recurse (or \c CXChildVisit_Continue
+ * if \p recurse is zero), but accumulates the visited cursors into one
+ * contiguous list instead of invoking a callback once per node.  Clients
+ * driving libclang through a foreign function interface can use this to
+ * traverse large translation units without paying the per-node callback
+ * overhead; the kind filter is evaluated during the traversal, so
+ * unwanted cursors are never materialized for the client.
+ *
+ * \param parent the cursor whose descendants should be collected.
+ *
+ * \param kinds an optional array of cursor kinds to keep.  Cursors of
+ * other kinds are still traversed, but not returned.  May be NULL, in
+ * which case every visited cursor is kept.
+ *
+ * \param num_kinds the number of entries in \p kinds.
+ *
+ * \param recurse if non-zero, collect from the entire subtree of
+ * \p parent; otherwise only its direct children are visited.
+ *
+ * \returns a list of the matching cursors, in the order the traversal
+ * visited them.  The list should be destroyed with
+ * \c clang_disposeCursorList().
+ */
+CINDEX_LINKAGE CXCursorList *clang_collectChildren(
+    CXCursor parent, const enum CXCursorKind *kinds, unsigned num_kinds,
+    unsigned recurse);
+
+/**
+ * Destroy the given \c CXCursorList.
+ */
+CINDEX_LINKAGE void clang_disposeCursorList(CXCursorList *cursors);
+
 /**
  * @}
  */
@@ -4925,6 +4973,47 @@ CINDEX_LINKAGE CXSourceRange clang_getTokenExtent(CXTranslationUnit, CXToken);
 CINDEX_LINKAGE void clang_tokenize(CXTranslationUnit TU, CXSourceRange Range,
                                    CXToken **Tokens, unsigned *NumTokens);
 
+/**
+ * A compact description of one token: its byte extent within its file
+ * and its kind.
+ */
+typedef struct {
+  /** The byte offset of the start of the token within its file. */
+  unsigned offset;
+  /** The length of the token in bytes. */
+  unsigned length;
+  /** The \c CXTokenKind of the token. */
+  unsigned kind;
+} CXTokenRecord;
+
+/**
+ * Describe a set of tokens as packed (offset, length, kind) records
+ * with a single call.
+ *
+ * This is equivalent to querying clang_getTokenExtent() and
+ * clang_getTokenKind() for each token and decomposing the resulting
+ * ranges, but performs one pass over the token array with amortized
+ * location decomposition (tokens are position-sorted, so the file query
+ * is resolved once), making bulk extraction — e.g. a semantic
+ * highlighter pulling every token of a file per refresh — cheap for
+ * clients behind a foreign function interface.  Cursor kinds, when
+ * needed, come from a single clang_annotateTokens() call over the same
+ * array.
+ *
+ * \param TU the translation unit that owns the given tokens.
+ *
+ * \param Tokens the tokens to describe, as produced by clang_tokenize().
+ *
+ * \param NumTokens the number of tokens in \p Tokens.
+ *
+ * \param Records a caller-allocated array of \p NumTokens records,
+ * filled in by this call.
+ */
+CINDEX_LINKAGE void clang_getTokenRecords(CXTranslationUnit TU,
+                                          const CXToken *Tokens,
+                                          unsigned NumTokens,
+                                          CXTokenRecord *Records);
+
 /**
  * Annotate the given set of tokens by providing cursors for each token
  * that can be mapped to a specific entity within the abstract syntax tree.
@@ -179,6 +179,26 @@ private:
   mutable llvm::FoldingSet<LValueReferenceType> LValueReferenceTypes;
   mutable llvm::FoldingSet<RValueReferenceType> RValueReferenceTypes;
   mutable llvm::FoldingSet<MemberPointerType> MemberPointerTypes;
+
+  /// Memo caches mapping a pointee/referencee with no local qualifiers
+  /// directly to its pointer or reference derivation.  These answer the
+  /// overwhelmingly common repeat derivations with a single DenseMap probe,
+  /// bypassing the FoldingSet profile-and-probe; misses fall through to the
+  /// FoldingSets above, which remain the source of truth for uniquing.
+  mutable llvm::DenseMap<const Type *, QualType> PointerTypeMemo;
+  mutable llvm::DenseMap<const Type *, QualType> LValueReferenceTypeMemo;
+  mutable llvm::DenseMap<const Type *, QualType> RValueReferenceTypeMemo;
+  mutable unsigned NumTypeMemoHits = 0;
+  mutable unsigned NumTypeMemoMisses = 0;
+
+  /// Printed type names keyed by the type's opaque pointer, as produced under
+  /// getPrintingPolicy() for diagnostics.  Overload-resolution note cascades
+  /// print the same handful of types hundreds of times; type nodes are never
+  /// destroyed, so entries (arena-allocated) stay valid for the lifetime of
+  /// the context.  Reset by setPrintingPolicy().
+  mutable llvm::DenseMap<const void *, StringRef> TypeNameCache;
+  mutable unsigned NumTypeNamePrints = 0;
+  mutable unsigned NumTypeNameCacheHits = 0;
   mutable llvm::FoldingSet<ConstantArrayType> ConstantArrayTypes;
   mutable llvm::FoldingSet<IncompleteArrayType> IncompleteArrayTypes;
   mutable std::vector<VariableArrayType*> VariableArrayTypes;
@@ -666,8 +686,16 @@ public:
 
   void setPrintingPolicy(const clang::PrintingPolicy &Policy) {
     PrintingPolicy = Policy;
+    // Cached type names were printed under the old policy.
+    TypeNameCache.clear();
   }
 
+  /// Return \p T printed under getPrintingPolicy(), memoized for the
+  /// lifetime of the context.  Intended for diagnostic formatting, where
+  /// the same types are printed over and over; the returned string lives
+  /// in the context's arena.
+  StringRef getCachedTypeName(QualType T) const;
+
   SourceManager& getSourceManager() { return SourceMgr; }
   const SourceManager& getSourceManager() const { return SourceMgr; }
 
@@ -1106,6 +1134,37 @@ public:
   void PrintStats() const;
   const SmallVectorImpl<Type *>& getTypes() const { return Types; }
 
+  /// A small Bloom-style filter over the identifier member names of a class
+  /// and all of its transitive bases.  \see getMemberNameFilter.
+  struct MemberNameFilter {
+    uint64_t Bits[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    bool Valid = false;
+  };
+
+  /// Retrieve the member-name filter for \p RD's hierarchy, building and
+  /// caching it on first use, or null if the hierarchy is not eligible for
+  /// filtering (incomplete, dependent, or backed by an external AST source,
+  /// where member names can appear lazily).
+  ///
+  /// Only identifier names are covered; implicitly declared members
+  /// (constructors, destructors, assignment operators) all have special
+  /// names and may be added to a complete class later, so queries for
+  /// special names must bypass the filter.
+  const MemberNameFilter *getMemberNameFilter(const CXXRecordDecl *RD) const;
+
+  /// Statistics for the member-name filters, reported by PrintStats().
+  mutable unsigned NumMemberNameFilterQueries = 0;
+  mutable unsigned NumMemberNameFilterRejections = 0;
+
+private:
+  /// Lazily built member-name filters, keyed by class definition; entries
+  /// with \c Valid false record hierarchies that cannot be filtered.
+  /// \see getMemberNameFilter.
+  mutable llvm::DenseMap<const CXXRecordDecl *, MemberNameFilter>
+      MemberNameFilters;
+
+public:
+
   BuiltinTemplateDecl *buildBuiltinTemplateDecl(BuiltinTemplateKind BTK,
                                                 const IdentifierInfo *II) const;
 
@@ -2904,6 +2963,10 @@ private:
   getObjCLayout(const ObjCInterfaceDecl *D,
                 const ObjCImplementationDecl *Impl) const;
 
+  /// Build an ASTRecordLayout from a layout the external AST source recorded
+  /// when \p D's AST file was built, or return null if none was recorded.
+  const ASTRecordLayout *loadImportedRecordLayout(const RecordDecl *D) const;
+
   /// A set of deallocations that should be performed when the
   /// ASTContext is destroyed.
   // FIXME: We really should have a better mechanism in the ASTContext to
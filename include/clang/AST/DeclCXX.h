@@ -1771,6 +1771,17 @@ public:
   bool lookupInBases(BaseMatchesCallback BaseMatches, CXXBasePaths &Paths,
                      bool LookupInDependent = false) const;
 
+  /// Determine whether this class or any of its base classes may declare a
+  /// member with the given name.
+  ///
+  /// Returns false only when the name is provably absent from the entire
+  /// hierarchy, allowing qualified name lookup to skip the base walk (and
+  /// the lazy construction of each base's lookup table).  May conservatively
+  /// return true; always returns true for non-identifier names and for
+  /// hierarchies that are incomplete, dependent, or backed by an external
+  /// AST source.
+  bool mayContainMemberName(DeclarationName Name) const;
+
   /// Base-class lookup callback that determines whether the given
   /// base class specifier refers to a specific class declaration.
   ///
@@ -304,6 +304,49 @@ public:
       llvm::DenseMap<const CXXRecordDecl *, CharUnits> &BaseOffsets,
       llvm::DenseMap<const CXXRecordDecl *, CharUnits> &VirtualBaseOffsets);
 
+  /// A record layout that was computed when the record's AST file was built
+  /// and carried along with it, so that importing translation units can skip
+  /// the layout builder entirely.  Unlike \c layoutRecordType, which supplies
+  /// externally-mandated offsets for the builder to respect, this is the
+  /// complete result of a previous run of the builder.
+  struct ImportedRecordLayout {
+    struct BaseInfo {
+      const CXXRecordDecl *Base;
+      CharUnits Offset;
+      bool HasVtorDisp; // Virtual bases only; Microsoft ABI.
+    };
+
+    CharUnits Size;
+    CharUnits DataSize;
+    CharUnits Alignment;
+    CharUnits UnadjustedAlignment;
+    CharUnits RequiredAlignment;
+    SmallVector<uint64_t, 16> FieldOffsets; // In bits.
+
+    /// Whether the C++-specific fields below are meaningful.
+    bool IsCXX = false;
+
+    CharUnits NonVirtualSize;
+    CharUnits NonVirtualAlignment;
+    CharUnits SizeOfLargestEmptySubobject;
+    CharUnits VBPtrOffset;
+    bool HasOwnVFPtr = false;
+    bool HasExtendableVFPtr = false;
+    bool EndsWithZeroSizedObject = false;
+    bool LeadsWithZeroSizedBase = false;
+    bool PrimaryBaseIsVirtual = false;
+    const CXXRecordDecl *PrimaryBase = nullptr;
+    const CXXRecordDecl *BaseSharingVBPtr = nullptr;
+    SmallVector<BaseInfo, 4> Bases;
+    SmallVector<BaseInfo, 4> VBases;
+  };
+
+  /// Fetch the layout recorded for \p Record when its AST file was built.
+  ///
+  /// \returns true if a layout was provided, false otherwise.
+  virtual bool getImportedRecordLayout(const RecordDecl *Record,
+                                       ImportedRecordLayout &Layout);
+
   //===--------------------------------------------------------------------===//
   // Queries for performance analysis.
   //===--------------------------------------------------------------------===//
@@ -59,6 +59,9 @@ public:
 
   using VBaseOffsetsMapTy = llvm::DenseMap<const CXXRecordDecl *, VBaseInfo>;
 
+  /// FIXME: This should really use a SmallPtrMap, once we have one in LLVM :)
+  using BaseOffsetsMapTy = llvm::DenseMap<const CXXRecordDecl *, CharUnits>;
+
 private:
   friend class ASTContext;
 
@@ -125,9 +128,6 @@ private:
     /// BaseSharingVBPtr - The base we share vbptr with.
     const CXXRecordDecl *BaseSharingVBPtr;
 
-    /// FIXME: This should really use a SmallPtrMap, once we have one in LLVM :)
-    using BaseOffsetsMapTy = llvm::DenseMap<const CXXRecordDecl *, CharUnits>;
-
     /// BaseOffsets - Contains a map from base classes to their offset.
     BaseOffsetsMapTy BaseOffsets;
 
@@ -144,8 +144,6 @@ private:
                   CharUnits requiredAlignment, CharUnits datasize,
                   ArrayRef<uint64_t> fieldoffsets);
 
-  using BaseOffsetsMapTy = CXXRecordLayoutInfo::BaseOffsetsMapTy;
-
   // Constructor for C++ records.
   ASTRecordLayout(const ASTContext &Ctx,
                   CharUnits size, CharUnits alignment,
@@ -317,6 +315,11 @@ public:
     assert(CXXInfo && "Record layout does not have C++ specific info!");
     return CXXInfo->VBaseOffsets;
   }
+
+  const BaseOffsetsMapTy &getBaseOffsetsMap() const {
+    assert(CXXInfo && "Record layout does not have C++ specific info!");
+    return CXXInfo->BaseOffsets;
+  }
 };
 
 } // namespace clang
@@ -438,6 +438,10 @@ private:
   /// Number of errors reported
   unsigned NumErrors;
 
+  /// Number of diagnostics discarded before any rendering because their
+  /// severity mapped to Ignored (e.g. under -w or a suppressing pragma).
+  unsigned NumSuppressed;
+
   /// A function pointer that converts an opaque diagnostic
   /// argument to a strings.
   ///
@@ -763,6 +767,8 @@ public:
     this->NumWarnings = NumWarnings;
   }
 
+  unsigned getNumSuppressed() const { return NumSuppressed; }
+
   /// Return an ID for a diagnostic with the specified format string and
   /// level.
   ///
@@ -19,6 +19,7 @@
 #include "clang/Basic/LLVM.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
@@ -236,9 +237,16 @@ public:
 
   /// Open the specified file as a MemoryBuffer, returning a new
   /// MemoryBuffer if successful, otherwise returning null.
+  ///
+  /// Pass \p RequiresNullTerminator = false for binary payloads (such as
+  /// AST/PCM files) that are consumed through a bitstream cursor; this lets
+  /// the buffer stay memory-mapped even when the file size is an exact
+  /// multiple of the page size, instead of being copied to the heap just to
+  /// append a NUL byte.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
   getBufferForFile(const FileEntry *Entry, bool isVolatile = false,
-                   bool ShouldCloseOpenFile = true);
+                   bool ShouldCloseOpenFile = true,
+                   bool RequiresNullTerminator = true);
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
   getBufferForFile(StringRef Filename, bool isVolatile = false);
 
@@ -269,6 +277,13 @@ public:
   void GetUniqueIDMapping(
                     SmallVectorImpl<const FileEntry *> &UIDToFiles) const;
 
+  /// Visit every path this FileManager has been asked about, including
+  /// lookups that failed, for which the FileEntry is null.  This allows
+  /// clients to revalidate a previous compilation's view of the file
+  /// system, negative results included.
+  void forEachSeenFileEntry(
+      llvm::function_ref<void(StringRef, const FileEntry *)> Visit) const;
+
   /// Modifies the size and modification time of a previously created
   /// FileEntry. Use with caution.
   static void modifyFileEntry(FileEntry *File, off_t Size,
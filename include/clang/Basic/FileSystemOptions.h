@@ -25,6 +25,11 @@ public:
   /// If set, paths are resolved as if the working directory was
   /// set to the value of WorkingDir.
   std::string WorkingDir;
+
+  /// If set, the FileManager answers negative file lookups from a
+  /// per-directory listing snapshot instead of issuing one stat per path
+  /// (see DirectoryScanStatCache).
+  bool CacheDirEntries = false;
 };
 
 } // end namespace clang
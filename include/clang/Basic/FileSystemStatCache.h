@@ -16,8 +16,10 @@
 #define LLVM_CLANG_BASIC_FILESYSTEMSTATCACHE_H
 
 #include "clang/Basic/LLVM.h"
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/FileSystem.h"
 #include <cstdint>
@@ -124,6 +126,31 @@ protected:
   }
 };
 
+/// A stat cache that lists each queried directory once and then answers
+/// negative file lookups from the listing, without touching the file system.
+///
+/// Header search probes every search directory for every #include, so on
+/// high-latency file systems (NFS) the misses dominate; one readdir per
+/// directory replaces one stat per candidate header.  Lookups of paths that
+/// are present in the listing still fall through, so existing files get real
+/// stat data (and open file descriptors) as usual.
+///
+/// This trades strict accuracy for speed and is therefore opt-in
+/// (-fcache-dir-entries): files created in a listed directory during the
+/// compilation are not noticed, and the name comparison is exact, so it
+/// assumes a case-sensitive file system.
+class DirectoryScanStatCache : public FileSystemStatCache {
+public:
+  LookupResult getStat(StringRef Path, FileData &Data, bool isFile,
+                       std::unique_ptr<llvm::vfs::File> *F,
+                       llvm::vfs::FileSystem &FS) override;
+
+private:
+  /// The filenames contained in each directory we have listed, or None if
+  /// listing the directory failed (lookups under it always fall through).
+  llvm::StringMap<llvm::Optional<llvm::StringSet<>>> DirEntries;
+};
+
 /// A stat "cache" that can be used by FileManager to keep
 /// track of the results of stat() calls that occur throughout the
 /// execution of the front end.
@@ -675,6 +675,15 @@ class SourceManager : public RefCountedBase<SourceManager> {
   /// is very common to look up many tokens from the same file.
   mutable FileID LastFileIDLookup;
 
+  /// A small victim cache behind LastFileIDLookup.
+  ///
+  /// Interleaved queries (diagnostics quoting one file while lexing another,
+  /// indexers walking headers) evict the one-entry cache on every switch;
+  /// keeping the last few distinct files avoids re-running the slow lookup
+  /// for each of them.  Entries are only ever probed with isOffsetInFileID,
+  /// so a stale FileID is a miss, never a wrong answer.
+  mutable FileID RecentFileIDLookups[3];
+
   /// Holds information for \#line directives.
   ///
   /// This is referenced by indices from SLocEntryTable.
@@ -696,6 +705,7 @@ class SourceManager : public RefCountedBase<SourceManager> {
   // Statistics for -print-stats.
   mutable unsigned NumLinearScans = 0;
   mutable unsigned NumBinaryProbes = 0;
+  mutable unsigned NumRecentCacheHits = 0;
 
   /// Associates a FileID with its "included/expanded in" decomposed
   /// location.
@@ -1051,6 +1061,16 @@ public:
     if (isOffsetInFileID(LastFileIDLookup, SLocOffset))
       return LastFileIDLookup;
 
+    // Then try the last few distinct files, promoting a hit to the front.
+    for (FileID &Recent : RecentFileIDLookups)
+      if (isOffsetInFileID(Recent, SLocOffset)) {
+        FileID Res = Recent;
+        Recent = LastFileIDLookup;
+        LastFileIDLookup = Res;
+        ++NumRecentCacheHits;
+        return Res;
+      }
+
     return getFileIDSlow(SLocOffset);
   }
 
@@ -1780,6 +1800,17 @@ private:
   FileID getFileIDLocal(unsigned SLocOffset) const;
   FileID getFileIDLoaded(unsigned SLocOffset) const;
 
+  /// Remember \p FID as the most recent getFileID result, demoting the
+  /// previous front-of-cache entry into the victim cache.
+  void rememberFileIDLookup(FileID FID) const {
+    if (FID == LastFileIDLookup)
+      return;
+    RecentFileIDLookups[2] = RecentFileIDLookups[1];
+    RecentFileIDLookups[1] = RecentFileIDLookups[0];
+    RecentFileIDLookups[0] = LastFileIDLookup;
+    LastFileIDLookup = FID;
+  }
+
   SourceLocation getExpansionLocSlowCase(SourceLocation Loc) const;
   SourceLocation getSpellingLocSlowCase(SourceLocation Loc) const;
   SourceLocation getFileLocSlowCase(SourceLocation Loc) const;
@@ -0,0 +1,87 @@
+//===- TimeTrace.h - Hierarchical time profiler -----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a lightweight hierarchical time profiler that emits
+// Chrome trace-viewer compatible JSON ("-ftime-trace").  Unlike the flat
+// -ftime-report timers, events nest, so a slow compile can be attributed to
+// a specific include, template instantiation or function being emitted.
+//
+// The profiler is a process-global singleton and is only intended to be
+// driven from the main thread of a -cc1 invocation.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_BASIC_TIMETRACE_H
+#define LLVM_CLANG_BASIC_TIMETRACE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include <string>
+
+namespace llvm {
+class raw_pwrite_stream;
+} // namespace llvm
+
+namespace clang {
+
+struct TimeTraceProfiler;
+
+/// Initialize the global profiler instance.  Must be called before any
+/// TimeTraceScope is entered; typically done by cc1_main when -ftime-trace
+/// is given.
+void timeTraceProfilerInitialize();
+
+/// Destroy the global profiler instance.  Any events still open are
+/// discarded.
+void timeTraceProfilerCleanup();
+
+/// Whether the global profiler instance exists.  Instrumentation sites use
+/// this to skip building detail strings when tracing is off.
+bool timeTraceProfilerEnabled();
+
+/// Write all completed events as Chrome trace JSON to \p OS.
+void timeTraceProfilerWrite(llvm::raw_pwrite_stream &OS);
+
+/// Manually open an event.  Prefer TimeTraceScope.
+void timeTraceProfilerBegin(StringRef Name, StringRef Detail);
+
+/// Close the innermost open event.
+void timeTraceProfilerEnd();
+
+/// RAII object that records one hierarchical event while it is in scope.
+///
+/// The detail callback is only invoked when the profiler is enabled, so
+/// callers can pass lambdas that build expensive strings (e.g. qualified
+/// names of template specializations) without penalizing normal compiles.
+struct TimeTraceScope {
+  TimeTraceScope(const TimeTraceScope &) = delete;
+  TimeTraceScope &operator=(const TimeTraceScope &) = delete;
+
+  TimeTraceScope(StringRef Name) {
+    if (timeTraceProfilerEnabled())
+      timeTraceProfilerBegin(Name, StringRef(""));
+  }
+  TimeTraceScope(StringRef Name, StringRef Detail) {
+    if (timeTraceProfilerEnabled())
+      timeTraceProfilerBegin(Name, Detail);
+  }
+  TimeTraceScope(StringRef Name, llvm::function_ref<std::string()> Detail) {
+    if (timeTraceProfilerEnabled())
+      timeTraceProfilerBegin(Name, Detail());
+  }
+  ~TimeTraceScope() {
+    if (timeTraceProfilerEnabled())
+      timeTraceProfilerEnd();
+  }
+};
+
+} // namespace clang
+
+#endif // LLVM_CLANG_BASIC_TIMETRACE_H
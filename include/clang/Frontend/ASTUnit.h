@@ -197,6 +197,17 @@ private:
   /// the next.
   unsigned NumStoredDiagnosticsFromDriver = 0;
 
+  /// If non-zero, the maximum number of stored diagnostics to retain per
+  /// (diagnostic ID, file) pair; further occurrences are counted in
+  /// \c NumStoredDiagnosticsOverflowed but not stored.  Zero means no cap.
+  ///
+  /// A single broken header can otherwise produce tens of thousands of
+  /// nearly identical diagnostics and dominate the unit's memory use.
+  unsigned StoredDiagnosticCap = 0;
+
+  /// The number of diagnostics dropped because of \c StoredDiagnosticCap.
+  unsigned NumStoredDiagnosticsOverflowed = 0;
+
   /// Counter that determines when we want to try building a
   /// precompiled preamble.
   ///
@@ -257,6 +268,13 @@ private:
 
   void clearFileLevelDecls();
 
+  /// Determine whether the inputs that went into the last parse of this
+  /// translation unit are unchanged, in which case Reparse can keep the
+  /// current AST instead of running the frontend again.
+  bool inputsUnchangedSinceParse(
+      ArrayRef<std::pair<std::string, llvm::MemoryBuffer *>> RemappedFiles,
+      llvm::vfs::FileSystem &VFS);
+
 public:
   /// A cached code-completion result, which may be introduced in one of
   /// many different contexts.
@@ -597,6 +615,17 @@ public:
 
   unsigned stored_diag_size() const { return StoredDiagnostics.size(); }
 
+  /// Limit the number of stored diagnostics retained per
+  /// (diagnostic ID, file) pair.  Zero (the default) disables the cap.
+  /// Takes effect at the next parse or reparse.
+  void setStoredDiagnosticCap(unsigned Cap) { StoredDiagnosticCap = Cap; }
+
+  /// The number of diagnostics dropped by the stored diagnostic cap during
+  /// the most recent parse.
+  unsigned getNumStoredDiagnosticsOverflowed() const {
+    return NumStoredDiagnosticsOverflowed;
+  }
+
   stored_diag_iterator stored_diag_afterDriver_begin() {
     if (NumStoredDiagnosticsFromDriver > StoredDiagnostics.size())
       NumStoredDiagnosticsFromDriver = 0;
@@ -697,6 +697,14 @@ public:
   /// Create the frontend timer and replace any existing one with it.
   void createFrontendTimer();
 
+  /// Write a JSON report of the memory held by the frontend's major arenas
+  /// (source manager, preprocessor, AST context, Sema) to \p OS.
+  ///
+  /// Only the subsystems that currently exist are reported, so this can be
+  /// called at any point in the compilation; -print-memory-usage calls it at
+  /// the end of each source file, while the per-file objects are still alive.
+  void writeMemoryUsageReport(raw_ostream &OS);
+
   /// Create the default output file (from the invocation's options) and add it
   /// to the list of tracked output files.
   ///
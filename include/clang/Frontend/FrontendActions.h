@@ -63,6 +63,12 @@ protected:
                                                  StringRef InFile) override;
 };
 
+class EmitDeclHashesAction : public ASTFrontendAction {
+protected:
+  std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI,
+                                                 StringRef InFile) override;
+};
+
 class ASTDeclListAction : public ASTFrontendAction {
 protected:
   std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI,
@@ -261,6 +267,11 @@ protected:
   void ExecuteAction() override;
 };
 
+class PrintTokenHashAction : public PreprocessorFrontendAction {
+protected:
+  void ExecuteAction() override;
+};
+
 class GeneratePTHAction : public PreprocessorFrontendAction {
 protected:
   void ExecuteAction() override;
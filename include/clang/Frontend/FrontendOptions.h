@@ -58,6 +58,10 @@ enum ActionKind {
   /// Emit a .bc file.
   EmitBC,
 
+  /// Parse ASTs and print a manifest of per-top-level-decl semantic
+  /// hashes, for build systems that diff interfaces between compiles.
+  EmitDeclHashes,
+
   /// Translate input source into HTML.
   EmitHTML,
 
@@ -112,6 +116,10 @@ enum ActionKind {
   /// -E mode.
   PrintPreprocessedInput,
 
+  /// Print a structural hash of the preprocessed token stream, suitable as
+  /// a build-cache key (no source coordinates, comments or whitespace).
+  PrintTokenHash,
+
   /// Expand macros but not \#includes.
   RewriteMacros,
 
@@ -257,9 +265,16 @@ public:
   /// Show frontend performance metrics and statistics.
   unsigned ShowStats : 1;
 
+  /// Print per-arena frontend memory usage as JSON when each source file is
+  /// finished.
+  unsigned ShowMemoryUsage : 1;
+
   /// Show timers for individual actions.
   unsigned ShowTimers : 1;
 
+  /// Output time trace profile.
+  unsigned TimeTrace : 1;
+
   /// Show the -version text.
   unsigned ShowVersion : 1;
 
@@ -441,7 +456,9 @@ public:
 public:
   FrontendOptions()
       : DisableFree(false), RelocatablePCH(false), ShowHelp(false),
-        ShowStats(false), ShowTimers(false), ShowVersion(false),
+        ShowStats(false), ShowMemoryUsage(false), ShowTimers(false),
+        TimeTrace(false),
+        ShowVersion(false),
         FixWhatYouCan(false), FixOnlyWarnings(false), FixAndRecompile(false),
         FixToTemporaries(false), ARCMTMigrateEmitARCErrors(false),
         SkipFunctionBodies(false), UseGlobalModuleIndex(true),
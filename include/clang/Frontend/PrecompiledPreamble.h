@@ -120,6 +120,20 @@ public:
                         IntrusiveRefCntPtr<llvm::vfs::FileSystem> &VFS,
                         llvm::MemoryBuffer *MainFileBuffer) const;
 
+  /// Serialize this preamble to \p Path: the preamble text, the metadata
+  /// CanReuse() validates against, and the PCH payload itself.  A preamble
+  /// written by one process can be picked up by a later one with
+  /// LoadFromFile(), so services that reopen the same files on every start
+  /// do not have to rebuild their preambles from scratch.
+  std::error_code StoreToFile(StringRef Path) const;
+
+  /// Load a preamble previously written by StoreToFile().  The PCH payload
+  /// is held in memory.  Fails on I/O errors and on files written by an
+  /// incompatible version of this code; staleness of the preamble inputs is
+  /// checked by CanReuse() as usual, and the PCH payload itself is still
+  /// fully validated by the ASTReader when it is consumed.
+  static llvm::ErrorOr<PrecompiledPreamble> LoadFromFile(StringRef Path);
+
 private:
   PrecompiledPreamble(PCHStorage Storage, std::vector<char> PreambleBytes,
                       bool PreambleEndsAtStartOfLine,
@@ -11,7 +11,9 @@
 #define LLVM_CLANG_INDEX_USRGENERATION_H
 
 #include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
+#include <utility>
 
 namespace clang {
 class Decl;
@@ -30,6 +32,17 @@ static inline StringRef getUSRSpacePrefix() {
 /// \returns true if the results should be ignored, false otherwise.
 bool generateUSRForDecl(const Decl *D, SmallVectorImpl<char> &Buf);
 
+/// Generate USRs for a batch of Decls, sharing the DeclContext prefix
+/// computation between decls from the same context.  The USRs are appended
+/// back-to-back to \p Buf and their (offset, length) pairs are recorded in
+/// \p USRRanges, in the order of \p Decls; a decl whose USR should be
+/// ignored gets a zero-length range.  The USRs produced are byte-for-byte
+/// identical to what generateUSRForDecl emits.
+void generateUSRsForDecls(ArrayRef<const Decl *> Decls,
+                          SmallVectorImpl<char> &Buf,
+                          SmallVectorImpl<std::pair<unsigned, unsigned>>
+                              &USRRanges);
+
 /// Generate a USR fragment for an Objective-C class.
 void generateUSRForObjCClass(StringRef Cls, raw_ostream &OS,
                              StringRef ExtSymbolDefinedIn = "",
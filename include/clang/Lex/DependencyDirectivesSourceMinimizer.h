@@ -0,0 +1,44 @@
+//===- DependencyDirectivesSourceMinimizer.h - -------------------*- C++-*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This is the interface for minimizing a source file down to the
+// preprocessor directives it contains, dropping everything the directives
+// do not need.  The result is itself valid preprocessor input, so a
+// dependency scan can feed it to a real Preprocessor and skip lexing the
+// large majority of header bytes that can never affect the include graph.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_DEPENDENCYDIRECTIVESSOURCEMINIMIZER_H
+#define LLVM_CLANG_LEX_DEPENDENCYDIRECTIVESSOURCEMINIMIZER_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace clang {
+
+/// Minimize the source \p Input to its preprocessor directives, appending
+/// them to \p Output one directive per line.
+///
+/// Non-directive lines are skipped wholesale; the scan only tracks the
+/// constructs that can change where a line ends or whether a '#' begins a
+/// directive (comments, string and character literals, raw strings, and
+/// escaped newlines).  Directive lines are copied verbatim, including any
+/// line continuations, so the output reparses with identical semantics for
+/// everything a dependency scan observes.
+///
+/// Returns true on a scan error (an unterminated block comment or raw
+/// string), in which case \p Output is not usable and the caller should
+/// fall back to the unminimized source.
+bool minimizeSourceToDependencyDirectives(llvm::StringRef Input,
+                                          llvm::SmallVectorImpl<char> &Output);
+
+} // end namespace clang
+
+#endif // LLVM_CLANG_LEX_DEPENDENCYDIRECTIVESSOURCEMINIMIZER_H
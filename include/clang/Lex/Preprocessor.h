@@ -41,6 +41,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/ADT/iterator_range.h"
@@ -151,6 +152,12 @@ class Preprocessor {
   /// objects internal to the Preprocessor.
   llvm::BumpPtrAllocator BP;
 
+  /// Stable copies of token spellings that required cleaning, keyed by the
+  /// raw encoding of the token location. Backs getSpellingInterned(); tokens
+  /// that do not need cleaning never land here since their spelling is a
+  /// slice of the source buffer or the identifier table.
+  llvm::DenseMap<unsigned, StringRef> InternedSpellings;
+
   /// Identifiers for builtin macros and other builtins.
   IdentifierInfo *Ident__LINE__, *Ident__FILE__;   // __LINE__, __FILE__
   IdentifierInfo *Ident__DATE__, *Ident__TIME__;   // __DATE__, __TIME__
@@ -715,6 +722,34 @@ private:
   unsigned NumTokenPaste = 0;
   unsigned NumFastTokenPaste = 0;
   unsigned NumSkipped = 0;
+  unsigned NumSkippedReplayed = 0;
+
+  /// Per-macro expansion telemetry: how often each macro was expanded and
+  /// how many replacement tokens those expansions produced.  Only collected
+  /// when \c CollectExpansionStats is set; reported by PrintStats().
+  struct MacroExpansionStats {
+    unsigned NumExpansions = 0;
+    unsigned NumReplacementTokens = 0;
+  };
+  bool CollectExpansionStats = false;
+  llvm::DenseMap<const IdentifierInfo *, MacroExpansionStats> ExpansionStats;
+
+  /// Per-pragma telemetry: how often each pragma (namespace) name was
+  /// dispatched.  Nested namespaces record at every level, so
+  /// "#pragma clang loop ..." counts both "clang" and "loop".  Only
+  /// collected when \c CollectPragmaStats is set; reported by PrintStats().
+  bool CollectPragmaStats = false;
+  llvm::StringMap<unsigned> PragmaUsageCounts;
+
+  /// Maps the '#' of an '#if' whose excluded block has already been skipped
+  /// once to the '#' of the directive the skip arrived at, so that skipping
+  /// the same block again (e.g. on re-inclusion of an #ifdef-heavy header)
+  /// can jump straight there instead of re-lexing the excluded region.  Both
+  /// pointers are into the file's MemoryBuffer, which is shared between all
+  /// inclusions of the file.  Entries are only recorded when the skip was
+  /// purely lexical (see SkipExcludedConditionalBlock), so replaying them is
+  /// valid under any macro state.
+  llvm::DenseMap<const char *, const char *> SkippedExcludedBlockCache;
 
   /// The predefined macros that preprocessor should use from the
   /// command line etc.
@@ -1620,6 +1655,17 @@ public:
                         SmallVectorImpl<char> &Buffer,
                         bool *Invalid = nullptr) const;
 
+  /// Get the spelling of a token as a StringRef whose storage lives as long
+  /// as the Preprocessor.
+  ///
+  /// Tokens that do not need cleaning yield a zero-copy slice of the source
+  /// buffer or the identifier table. Spellings that do need cleaning
+  /// (trigraphs, escaped newlines, UCNs) are copied into the preprocessor's
+  /// allocator once and reused on later requests for the same token, so
+  /// callers that only need to inspect or compare the text avoid a transient
+  /// std::string per token.
+  StringRef getSpellingInterned(const Token &Tok, bool *Invalid = nullptr);
+
   /// Relex the token at the specified location.
   /// \returns true if there was a failure, false on success.
   bool getRawToken(SourceLocation Loc, Token &Result,
@@ -1717,6 +1763,19 @@ public:
   void DumpMacro(const MacroInfo &MI) const;
   void dumpMacroInfo(const IdentifierInfo *II);
 
+  /// Start recording per-macro expansion counts and token-output volume.
+  /// PrintStats() reports the heaviest macros when this is enabled.
+  void enableMacroExpansionStats() { CollectExpansionStats = true; }
+
+  /// Start recording per-pragma dispatch counts for PrintStats().
+  void enablePragmaUsageStats() { CollectPragmaStats = true; }
+
+  /// Note that a pragma (namespace) name was dispatched to a handler.
+  void recordPragmaUse(StringRef Name) {
+    if (CollectPragmaStats)
+      ++PragmaUsageCounts[Name];
+  }
+
   /// Given a location that specifies the start of a
   /// token, return a new location that specifies a character within the token.
   SourceLocation AdvanceToTokenCharacter(SourceLocation TokStart,
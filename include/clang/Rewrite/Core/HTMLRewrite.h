@@ -16,6 +16,7 @@
 #define LLVM_CLANG_REWRITE_CORE_HTMLREWRITE_H
 
 #include "clang/Basic/SourceLocation.h"
+#include <memory>
 #include <string>
 
 namespace clang {
@@ -66,15 +67,34 @@ namespace html {
   void AddHeaderFooterInternalBuiltinCSS(Rewriter &R, FileID FID,
                                          StringRef title);
 
+  /// A cache for the highlight insertions computed by SyntaxHighlight and
+  /// HighlightMacros.  Those passes relex (and in the macro case re-preprocess)
+  /// the entire file, but the edits they produce depend only on the file
+  /// contents; consumers that rewrite the same file many times (e.g. one HTML
+  /// page per analyzer report) can share one cache across all rewrites so the
+  /// expensive recomputation happens only once per file.
+  class RelexRewriteCache;
+  using RelexRewriteCacheRef = std::shared_ptr<RelexRewriteCache>;
+
+  /// Creates a freshly initialized cache for use with SyntaxHighlight and
+  /// HighlightMacros.  The cache must not outlive the SourceManager that the
+  /// cached FileIDs refer to.
+  RelexRewriteCacheRef instantiateRelexRewriteCache();
+
   /// SyntaxHighlight - Relex the specified FileID and annotate the HTML with
-  /// information about keywords, comments, etc.
-  void SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP);
+  /// information about keywords, comments, etc.  If a non-null \p Cache is
+  /// supplied, the edits are replayed from it when possible instead of
+  /// relexing the file.
+  void SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP,
+                       RelexRewriteCacheRef Cache = nullptr);
 
   /// HighlightMacros - This uses the macro table state from the end of the
   /// file, to reexpand macros and insert (into the HTML) information about the
   /// macro expansions.  This won't be perfectly perfect, but it will be
-  /// reasonably close.
-  void HighlightMacros(Rewriter &R, FileID FID, const Preprocessor &PP);
+  /// reasonably close.  If a non-null \p Cache is supplied, the edits are
+  /// replayed from it when possible instead of re-preprocessing the file.
+  void HighlightMacros(Rewriter &R, FileID FID, const Preprocessor &PP,
+                       RelexRewriteCacheRef Cache = nullptr);
 
 } // end html namespace
 } // end clang namespace
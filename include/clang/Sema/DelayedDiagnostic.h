@@ -196,6 +196,12 @@ public:
 
   ArrayRef<SourceLocation> getAvailabilitySelectorLocs() const {
     assert(Kind == Availability && "Not an availability diagnostic.");
+    // A single use location is stored inline in Loc; see makeAvailability.
+    if (!AvailabilityData.SelectorLocs) {
+      assert(AvailabilityData.NumSelectorLocs == 1 &&
+             "only a single location is stored inline");
+      return llvm::makeArrayRef(&Loc, 1);
+    }
     return llvm::makeArrayRef(AvailabilityData.SelectorLocs,
                               AvailabilityData.NumSelectorLocs);
   }
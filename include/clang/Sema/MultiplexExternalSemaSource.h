@@ -189,6 +189,11 @@ public:
                  llvm::DenseMap<const CXXRecordDecl *,
                                 CharUnits> &VirtualBaseOffsets) override;
 
+  /// Fetch a record layout that was computed when the record's AST file was
+  /// built; queries subsequent sources until one provides a layout.
+  bool getImportedRecordLayout(const RecordDecl *Record,
+                               ImportedRecordLayout &Layout) override;
+
   /// Return the amount of memory used by memory buffers, breaking down
   /// by heap-backed versus mmap'ed memory.
   void getMemoryBufferSizes(MemoryBufferSizes &sizes) const override;
@@ -36,9 +36,11 @@
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MemAlloc.h"
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <utility>
 
 namespace clang {
@@ -825,6 +827,89 @@ class Sema;
     }
   };
 
+  /// A free list of fixed-size allocation slabs retained across overload
+  /// resolutions.
+  ///
+  /// OverloadCandidateSet instances are short-lived stack objects, but in
+  /// template-heavy code they routinely overflow their inline
+  /// conversion-sequence storage and pay a malloc/free pair per call
+  /// expression.  Sema owns one pool and threads it into the candidate sets
+  /// it builds so the overflow slabs are recycled instead.  Nested
+  /// resolutions are safe: a slab popped from the free list is owned by
+  /// exactly one live set until that set is destroyed.
+  class OverloadCandidateSetSlabPool {
+    SmallVector<void *, 4> FreeSlabs;
+
+  public:
+    /// Matches BumpPtrAllocator's default slab size; only slabs of exactly
+    /// this size are recycled.
+    static constexpr size_t SlabSize = 4096;
+
+    /// Cap on retained slabs so a deep nesting spike does not pin memory
+    /// for the rest of the Sema's lifetime.
+    static constexpr unsigned MaxFreeSlabs = 8;
+
+    OverloadCandidateSetSlabPool() = default;
+    OverloadCandidateSetSlabPool(const OverloadCandidateSetSlabPool &) = delete;
+    OverloadCandidateSetSlabPool &
+    operator=(const OverloadCandidateSetSlabPool &) = delete;
+
+    ~OverloadCandidateSetSlabPool() {
+      for (void *Slab : FreeSlabs)
+        std::free(Slab);
+    }
+
+    void *allocate() {
+      if (!FreeSlabs.empty())
+        return FreeSlabs.pop_back_val();
+      return llvm::safe_malloc(SlabSize);
+    }
+
+    void deallocate(void *Slab) {
+      if (FreeSlabs.size() < MaxFreeSlabs) {
+        FreeSlabs.push_back(Slab);
+        return;
+      }
+      std::free(Slab);
+    }
+  };
+
+  /// Adapts an OverloadCandidateSetSlabPool to the allocator interface
+  /// expected by BumpPtrAllocatorImpl.  Standard-size slabs come from and
+  /// return to the pool; oversized slabs, and all slabs when no pool is
+  /// attached, fall back to malloc.
+  class PooledOverloadSlabAllocator
+      : public llvm::AllocatorBase<PooledOverloadSlabAllocator> {
+    OverloadCandidateSetSlabPool *Pool = nullptr;
+
+  public:
+    PooledOverloadSlabAllocator() = default;
+    explicit PooledOverloadSlabAllocator(OverloadCandidateSetSlabPool *Pool)
+        : Pool(Pool) {}
+
+    void Reset() {}
+
+    LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size,
+                                                  size_t /*Alignment*/) {
+      if (Pool && Size == OverloadCandidateSetSlabPool::SlabSize)
+        return Pool->allocate();
+      return llvm::safe_malloc(Size);
+    }
+
+    // Pull in base class overloads.
+    using AllocatorBase<PooledOverloadSlabAllocator>::Allocate;
+
+    void Deallocate(const void *Ptr, size_t Size) {
+      if (Pool && Size == OverloadCandidateSetSlabPool::SlabSize) {
+        Pool->deallocate(const_cast<void *>(Ptr));
+        return;
+      }
+      std::free(const_cast<void *>(Ptr));
+    }
+
+    using AllocatorBase<PooledOverloadSlabAllocator>::Deallocate;
+  };
+
   /// OverloadCandidateSet - A set of overload candidates, used in C++
   /// overload resolution (C++ 13.3).
   class OverloadCandidateSet {
@@ -856,8 +941,9 @@ class Sema;
     llvm::SmallPtrSet<Decl *, 16> Functions;
 
     // Allocator for ConversionSequenceLists. We store the first few of these
-    // inline to avoid allocation for small sets.
-    llvm::BumpPtrAllocator SlabAllocator;
+    // inline to avoid allocation for small sets, and recycle overflow slabs
+    // through the per-Sema pool when one was provided at construction.
+    llvm::BumpPtrAllocatorImpl<PooledOverloadSlabAllocator> SlabAllocator;
 
     SourceLocation Loc;
     CandidateSetKind Kind;
@@ -896,8 +982,10 @@ class Sema;
     void destroyCandidates();
 
   public:
-    OverloadCandidateSet(SourceLocation Loc, CandidateSetKind CSK)
-        : Loc(Loc), Kind(CSK) {}
+    OverloadCandidateSet(SourceLocation Loc, CandidateSetKind CSK,
+                         OverloadCandidateSetSlabPool *SlabPool = nullptr)
+        : SlabAllocator(PooledOverloadSlabAllocator(SlabPool)), Loc(Loc),
+          Kind(CSK) {}
     OverloadCandidateSet(const OverloadCandidateSet &) = delete;
     OverloadCandidateSet &operator=(const OverloadCandidateSet &) = delete;
     ~OverloadCandidateSet() { destroyCandidates(); }
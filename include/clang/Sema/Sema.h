@@ -159,6 +159,7 @@ namespace clang {
   class OMPClause;
   struct OverloadCandidate;
   class OverloadCandidateSet;
+  class OverloadCandidateSetSlabPool;
   class OverloadExpr;
   class ParenListExpr;
   class ParmVarDecl;
@@ -1089,6 +1090,14 @@ public:
   /// attribute.
   mutable llvm::DenseMap<const EnumDecl*, llvm::APInt> FlagBitsCache;
 
+  /// Recycled slab storage threaded into the OverloadCandidateSets built
+  /// during overload resolution, created lazily on first use.
+  std::unique_ptr<OverloadCandidateSetSlabPool> OverloadSlabPool;
+
+  /// Retrieve the slab pool for overload candidate sets, creating it if
+  /// necessary.
+  OverloadCandidateSetSlabPool &getOverloadSlabPool();
+
   /// The kind of translation unit we are processing.
   ///
   /// When we're processing a complete translation unit, Sema will perform
@@ -1103,6 +1112,35 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of class definitions instantiated in this translation unit.
+  unsigned NumClassDefinitionsInstantiated;
+
+  /// The number of function definitions instantiated in this translation
+  /// unit.
+  unsigned NumFunctionDefinitionsInstantiated;
+
+  /// The number of requests to instantiate a function definition that were
+  /// satisfied by an already-available definition (a previous instantiation
+  /// in this TU, or one imported from a PCH or module).
+  unsigned NumFunctionDefinitionsReused;
+
+  /// The number of scope name lookups performed (Sema::LookupName).
+  unsigned NumNameLookups;
+
+  /// The number of call expressions analyzed (Sema::ActOnCallExpr).
+  unsigned NumCallExprsAnalyzed;
+
+  /// The number of template-ids checked (Sema::CheckTemplateIdType).
+  unsigned NumTemplateIdsChecked;
+
+  /// The number of overload resolutions run, the total number of candidates
+  /// they considered, and the largest single candidate set.  Together these
+  /// identify translation units that are slow because of a few huge overload
+  /// sets rather than many small ones.
+  unsigned NumOverloadResolutions;
+  unsigned NumOverloadCandidatesConsidered;
+  unsigned MaxOverloadCandidates;
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
@@ -2049,7 +2087,11 @@ public:
   void computeNRVO(Stmt *Body, sema::FunctionScopeInfo *Scope);
   Decl *ActOnFinishFunctionBody(Decl *Decl, Stmt *Body);
   Decl *ActOnFinishFunctionBody(Decl *Decl, Stmt *Body, bool IsInstantiation);
-  Decl *ActOnSkippedFunctionBody(Decl *Decl);
+  /// \param BodyEnd if valid, the location of the last token of the skipped
+  /// body; recorded as the declaration's end so that a later pass can re-lex
+  /// and parse exactly the skipped range on demand.
+  Decl *ActOnSkippedFunctionBody(Decl *Decl,
+                                 SourceLocation BodyEnd = SourceLocation());
   void ActOnFinishInlineFunctionDef(FunctionDecl *D);
 
   /// ActOnFinishDelayedAttribute - Invoked when we have finished parsing an
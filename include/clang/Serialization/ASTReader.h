@@ -762,6 +762,13 @@ private:
   /// the skipped ranges reside.
   GlobalSkippedRangeMapType GlobalSkippedRangeMap;
 
+  /// Record layouts carried by AST files, keyed by the global declaration ID
+  /// of the record. The payload is a RECORD_LAYOUTS entry with all local
+  /// declaration IDs already translated to global ones; it is decoded on
+  /// demand by getImportedRecordLayout().
+  llvm::DenseMap<serialization::DeclID, SmallVector<uint64_t, 16>>
+      ImportedRecordLayouts;
+
   /// \name CodeGen-relevant special data
   /// Fields containing data that is relevant to CodeGen.
   //@{
@@ -1011,6 +1018,31 @@ private:
   /// Number of visible decl contexts read/total.
   unsigned NumVisibleDeclContextsRead = 0, TotalVisibleDeclContexts = 0;
 
+  /// Number of redeclaration chains linked together from AST files, with
+  /// the total and maximum number of previous-declaration links attached
+  /// while doing so.  Chain linking is linear in the number of modules
+  /// contributing redeclarations, so growth here is the early warning for
+  /// quadratic behavior in heavily modular builds.
+  unsigned NumRedeclChainsLoaded = 0;
+  unsigned NumRedeclLinksAttached = 0;
+  unsigned MaxRedeclChainLinks = 0;
+
+  /// Number of declaration reads triggered directly by a consumer request,
+  /// and the number triggered transitively by another read.  Their ratio
+  /// is the read amplification of the current lookup patterns.
+  unsigned NumDeclReadsRequested = 0;
+  unsigned NumCascadedDeclReads = 0;
+
+  /// Indexes into DeclsLoaded of the declaration reads currently in
+  /// progress, outermost first.  Maintained only when a deserialization
+  /// trace is requested via -deserialization-trace-file.
+  SmallVector<unsigned, 8> DeserializationTraceStack;
+
+  /// Output stream for the deserialization trace; opened on first use,
+  /// left null with the flag below set if opening failed.
+  std::unique_ptr<llvm::raw_ostream> DeserializationTraceOS;
+  bool DeserializationTraceFailed = false;
+
   /// Total size of modules, in bits, currently loaded
   uint64_t TotalModulesSizeInBits = 0;
 
@@ -1212,6 +1244,10 @@ private:
     bool Overridden;
     bool Transient;
     bool TopLevelModuleMap;
+
+    /// xxHash of the file contents at the time the AST file was written, or
+    /// zero if no hash was recorded.
+    uint64_t ContentHash;
   };
 
   /// Reads the stored information about an input file.
@@ -1344,6 +1380,7 @@ private:
   RecordLocation TypeCursorForIndex(unsigned Index);
   void LoadedDecl(unsigned Index, Decl *D);
   Decl *ReadDeclRecord(serialization::DeclID ID);
+  void writeDeserializationTraceLine();
   void markIncompleteDeclChain(Decl *Canon);
 
   /// Returns the most recent declaration of a declaration (which must be
@@ -1888,6 +1925,11 @@ public:
   /// redeclaration chain for \p D.
   void CompleteRedeclChain(const Decl *D) override;
 
+  /// Fetch the record layout that was computed when \p Record's AST file was
+  /// built, if one was serialized with it.
+  bool getImportedRecordLayout(const RecordDecl *Record,
+                               ImportedRecordLayout &Layout) override;
+
   CXXBaseSpecifier *GetExternalCXXBaseSpecifiers(uint64_t Offset) override;
 
   /// Resolve the offset of a statement into a statement.
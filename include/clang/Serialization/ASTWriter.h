@@ -512,6 +512,7 @@ private:
   void WriteMSStructPragmaOptions(Sema &SemaRef);
   void WriteMSPointersToMembersPragmaOptions(Sema &SemaRef);
   void WritePackPragmaOptions(Sema &SemaRef);
+  void WriteRecordLayouts(ASTContext &Context);
   void WriteModuleFileExtension(Sema &SemaRef,
                                 ModuleFileExtensionWriter &Writer);
 
@@ -531,6 +532,8 @@ private:
   unsigned CharacterLiteralAbbrev = 0;
   unsigned IntegerLiteralAbbrev = 0;
   unsigned ExprImplicitCastAbbrev = 0;
+  unsigned ExprParenAbbrev = 0;
+  unsigned ExprBinaryOperatorAbbrev = 0;
 
   void WriteDeclAbbrevs();
   void WriteDecl(ASTContext &Context, Decl *D);
@@ -694,6 +697,10 @@ public:
   unsigned getCharacterLiteralAbbrev() const { return CharacterLiteralAbbrev; }
   unsigned getIntegerLiteralAbbrev() const { return IntegerLiteralAbbrev; }
   unsigned getExprImplicitCastAbbrev() const { return ExprImplicitCastAbbrev; }
+  unsigned getExprParenAbbrev() const { return ExprParenAbbrev; }
+  unsigned getExprBinaryOperatorAbbrev() const {
+    return ExprBinaryOperatorAbbrev;
+  }
 
   bool hasChain() const { return Chain; }
   ASTReader *getChain() const { return Chain; }
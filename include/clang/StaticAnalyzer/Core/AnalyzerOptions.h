@@ -138,6 +138,11 @@ public:
 
   std::string AnalyzeSpecificFunction;
 
+  /// Comma-separated list of <file>:<line>[-<line>] ranges; when non-empty,
+  /// analysis is restricted to functions whose bodies intersect one of the
+  /// ranges (or, when inlining is enabled, reach one through calls).
+  std::string AnalyzeRegionsOfInterest;
+
   /// File path to which the exploded graph should be dumped.
   std::string DumpExplodedGraphTo;
 
@@ -168,6 +173,9 @@ public:
   unsigned UnoptimizedCFG : 1;
   unsigned PrintStats : 1;
 
+  /// Collect and print the time spent in each checker's callbacks.
+  unsigned CheckerProfiling : 1;
+
   /// Do not re-analyze paths leading to exhausted nodes with a different
   /// strategy. We get better code coverage when retry is enabled.
   unsigned NoRetryExhausted : 1;
@@ -295,6 +303,9 @@ private:
   /// \sa getMaxNodesPerTopLevelFunction
   Optional<unsigned> MaxNodesPerTopLevelFunction;
 
+  /// \sa getMaxMemoryMBPerTopLevelFunction
+  Optional<unsigned> MaxMemoryMBPerTopLevelFunction;
+
   /// \sa shouldInlineLambdas
   Optional<bool> InlineLambdas;
 
@@ -325,6 +336,12 @@ private:
   /// \sa naiveCTUEnabled
   Optional<bool> NaiveCTU;
 
+  /// \sa getInlineSummariesInputFile
+  Optional<StringRef> InlineSummariesInputFile;
+
+  /// \sa getInlineSummariesOutputFile
+  Optional<StringRef> InlineSummariesOutputFile;
+
   /// \sa shouldElideConstructors
   Optional<bool> ElideConstructors;
 
@@ -363,7 +380,8 @@ public:
         eagerlyAssumeBinOpBifurcation(false), TrimGraph(false),
         visualizeExplodedGraphWithGraphViz(false),
         UnoptimizedCFG(false),
-        PrintStats(false), NoRetryExhausted(false), CXXMemberInliningMode() {}
+        PrintStats(false), CheckerProfiling(false), NoRetryExhausted(false),
+        CXXMemberInliningMode() {}
 
   /// Interprets an option's string value as a boolean. The "true" string is
   /// interpreted as true and the "false" string is interpreted as false.
@@ -676,6 +694,15 @@ public:
   /// This is controlled by the 'max-nodes' config option.
   unsigned getMaxNodesPerTopLevelFunction();
 
+  /// Returns the maximum amount of memory, in megabytes, the exploded graph
+  /// (nodes, states, environments and store bindings share its allocator) may
+  /// consume while exploring a top level function before the worklist is
+  /// abandoned, the same way the 'max-nodes' budget cuts exploration short.
+  /// 0 is default and means no limit.
+  ///
+  /// This is controlled by the 'max-memory-mb' config option.
+  unsigned getMaxMemoryMBPerTopLevelFunction();
+
   /// Returns true if lambdas should be inlined. Otherwise a sink node will be
   /// generated each time a LambdaExpr is visited.
   bool shouldInlineLambdas();
@@ -739,6 +766,14 @@ public:
   /// translation units.
   bool naiveCTUEnabled();
 
+  /// Returns the file from which inlining verdicts recorded by a previous
+  /// run are preloaded, or an empty string when disabled.
+  StringRef getInlineSummariesInputFile();
+
+  /// Returns the file to which this run's inlining verdicts are written,
+  /// or an empty string when disabled.
+  StringRef getInlineSummariesOutputFile();
+
   /// Returns true if elidable C++ copy-constructors and move-constructors
   /// should be actually elided during analysis. Both behaviors are allowed
   /// by the C++ standard, and the analyzer, like CodeGen, defaults to eliding.
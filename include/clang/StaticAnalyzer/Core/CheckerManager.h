@@ -22,8 +22,16 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
+#include <memory>
 #include <vector>
 
+namespace llvm {
+
+class Timer;
+class TimerGroup;
+
+} // namespace llvm
+
 namespace clang {
 
 class AnalyzerOptions;
@@ -133,6 +141,11 @@ public:
 
   void finishedCheckerRegistration();
 
+  /// Return the timer accounting for the given checker's callbacks, or null
+  /// when checker profiling is disabled. The per-checker report is printed
+  /// when the manager is destroyed.
+  llvm::Timer *getCheckerTimer(CheckerBase *Checker);
+
   const LangOptions &getLangOpts() const { return LangOpts; }
   AnalyzerOptions &getAnalyzerOptions() { return AOptions; }
   ASTContext &getASTContext() { return Context; }
@@ -593,6 +606,12 @@ private:
   const CachedStmtCheckers &getCachedStmtCheckersFor(const Stmt *S,
                                                      bool isPreVisit);
 
+  /// Lazily-created per-checker timers, populated by getCheckerTimer() when
+  /// \c AnalyzerOptions::CheckerProfiling is set. The group must outlive the
+  /// timers so that destroying the manager prints the report.
+  std::unique_ptr<llvm::TimerGroup> CheckerTimerGroup;
+  llvm::DenseMap<CheckerBase *, std::unique_ptr<llvm::Timer>> CheckerTimers;
+
   /// Returns the checkers that have registered for callbacks of the
   /// given \p Kind.
   const std::vector<CheckObjCMessageFunc> &
@@ -20,9 +20,11 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/None.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallBitVector.h"
 #include <cassert>
 #include <deque>
+#include <functional>
 #include <utility>
 
 namespace clang {
@@ -59,6 +61,25 @@ class FunctionSummariesTy {
   MapTy Map;
 
 public:
+  /// Optional callback consulted the first time an inlining verdict is
+  /// requested for a declaration this run has not classified yet.  It allows
+  /// verdicts recorded by a previous run to be replayed; returning None
+  /// means nothing is known about the declaration.
+  using ExternalInlineVerdictTy = std::function<Optional<bool>(const Decl *)>;
+
+  void setExternalInlineVerdict(ExternalInlineVerdictTy Fn) {
+    ExternalInlineVerdict = std::move(Fn);
+  }
+
+  /// Visit the inlining verdict recorded for each declaration that has been
+  /// checked against the inlining rules during this run.
+  void forEachInlineVerdict(
+      llvm::function_ref<void(const Decl *, bool MayInline)> Visit) const {
+    for (const auto &I : Map)
+      if (I.second.InlineChecked)
+        Visit(I.first, I.second.MayInline);
+  }
+
   MapTy::iterator findOrInsertSummary(const Decl *D) {
     MapTy::iterator I = Map.find(D);
     if (I != Map.end())
@@ -91,6 +112,17 @@ public:
     MapTy::const_iterator I = Map.find(D);
     if (I != Map.end() && I->second.InlineChecked)
       return I->second.MayInline;
+    if (ExternalInlineVerdict) {
+      if (Optional<bool> Verdict = ExternalInlineVerdict(D)) {
+        // Cache the replayed verdict so the callback runs at most once per
+        // declaration.
+        if (*Verdict)
+          markMayInline(D);
+        else
+          markShouldNotInline(D);
+        return Verdict;
+      }
+    }
     return None;
   }
 
@@ -135,6 +167,9 @@ public:
 
   unsigned getTotalNumBasicBlocks();
   unsigned getTotalNumVisitedBasicBlocks();
+
+private:
+  ExternalInlineVerdictTy ExternalInlineVerdict;
 };
 
 } // namespace ento
@@ -329,6 +329,16 @@ bool applyAllReplacements(const Replacements &Replaces, Rewriter &Rewrite);
 llvm::Expected<std::string> applyAllReplacements(StringRef Code,
                                                  const Replacements &Replaces);
 
+/// Applies all replacements in \p Replaces to \p Code, streaming the patched
+/// result to \p OS instead of materializing it.
+///
+/// Prefer this over the std::string overload when writing the result straight
+/// to a file: tree-wide tools applying edits to many large files avoid
+/// allocating each patched file as a temporary. Error semantics match the
+/// std::string overload.
+llvm::Error applyAllReplacements(StringRef Code, const Replacements &Replaces,
+                                 llvm::raw_ostream &OS);
+
 /// Collection of Replacements generated from a single translation unit.
 struct TranslationUnitReplacements {
   /// Name of the main source for the translation unit.
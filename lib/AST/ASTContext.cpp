@@ -896,6 +896,16 @@ void ASTContext::PrintStats() const {
 
   llvm::errs() << "Total bytes = " << TotalBytes << "\n";
 
+  llvm::errs() << NumTypeMemoHits << "/"
+               << (NumTypeMemoHits + NumTypeMemoMisses)
+               << " pointer/reference derivations served from the memo "
+                  "caches (FoldingSet probes avoided)\n";
+  llvm::errs() << NumMemberNameFilterRejections << "/"
+               << NumMemberNameFilterQueries
+               << " member lookups rejected by hierarchy name filters\n";
+  llvm::errs() << NumTypeNameCacheHits << "/" << NumTypeNamePrints
+               << " diagnostic type names served from the print cache\n";
+
   // Implicit special member functions.
   llvm::errs() << NumImplicitDefaultConstructorsDeclared << "/"
                << NumImplicitDefaultConstructors
@@ -926,6 +936,21 @@ void ASTContext::PrintStats() const {
   BumpAlloc.PrintStats();
 }
 
+StringRef ASTContext::getCachedTypeName(QualType T) const {
+  ++NumTypeNamePrints;
+  StringRef &Entry = TypeNameCache[T.getAsOpaquePtr()];
+  if (Entry.data()) {
+    ++NumTypeNameCacheHits;
+    return Entry;
+  }
+
+  std::string S = T.getAsString(getPrintingPolicy());
+  char *Mem = new (*this) char[S.size()];
+  memcpy(Mem, S.data(), S.size());
+  Entry = StringRef(Mem, S.size());
+  return Entry;
+}
+
 void ASTContext::mergeDefinitionIntoModule(NamedDecl *ND, Module *M,
                                            bool NotifyListeners) {
   if (NotifyListeners)
@@ -2781,14 +2806,29 @@ QualType ASTContext::getComplexType(QualType T) const {
 /// getPointerType - Return the uniqued reference to the type for a pointer to
 /// the specified type.
 QualType ASTContext::getPointerType(QualType T) const {
+  // For pointees with no local qualifiers (the overwhelmingly common case),
+  // check the memo cache before profiling for the FoldingSet.
+  bool Memoizable = !T.hasLocalQualifiers();
+  if (Memoizable) {
+    auto Memo = PointerTypeMemo.find(T.getTypePtr());
+    if (Memo != PointerTypeMemo.end()) {
+      ++NumTypeMemoHits;
+      return Memo->second;
+    }
+    ++NumTypeMemoMisses;
+  }
+
   // Unique pointers, to guarantee there is only one pointer of a particular
   // structure.
   llvm::FoldingSetNodeID ID;
   PointerType::Profile(ID, T);
 
   void *InsertPos = nullptr;
-  if (PointerType *PT = PointerTypes.FindNodeOrInsertPos(ID, InsertPos))
+  if (PointerType *PT = PointerTypes.FindNodeOrInsertPos(ID, InsertPos)) {
+    if (Memoizable)
+      PointerTypeMemo[T.getTypePtr()] = QualType(PT, 0);
     return QualType(PT, 0);
+  }
 
   // If the pointee type isn't canonical, this won't be a canonical type either,
   // so fill in the canonical type field.
@@ -2803,6 +2843,8 @@ QualType ASTContext::getPointerType(QualType T) const {
   auto *New = new (*this, TypeAlignment) PointerType(T, Canonical);
   Types.push_back(New);
   PointerTypes.InsertNode(New, InsertPos);
+  if (Memoizable)
+    PointerTypeMemo[T.getTypePtr()] = QualType(New, 0);
   return QualType(New, 0);
 }
 
@@ -2904,6 +2946,18 @@ ASTContext::getLValueReferenceType(QualType T, bool SpelledAsLValue) const {
   assert(getCanonicalType(T) != OverloadTy &&
          "Unresolved overloaded function type");
 
+  // Memoize only the spelled-as-lvalue form of unqualified referencees; the
+  // rare spelled-as-rvalue collapse takes the generic path.
+  bool Memoizable = SpelledAsLValue && !T.hasLocalQualifiers();
+  if (Memoizable) {
+    auto Memo = LValueReferenceTypeMemo.find(T.getTypePtr());
+    if (Memo != LValueReferenceTypeMemo.end()) {
+      ++NumTypeMemoHits;
+      return Memo->second;
+    }
+    ++NumTypeMemoMisses;
+  }
+
   // Unique pointers, to guarantee there is only one pointer of a particular
   // structure.
   llvm::FoldingSetNodeID ID;
@@ -2911,8 +2965,11 @@ ASTContext::getLValueReferenceType(QualType T, bool SpelledAsLValue) const {
 
   void *InsertPos = nullptr;
   if (LValueReferenceType *RT =
-        LValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos))
+        LValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos)) {
+    if (Memoizable)
+      LValueReferenceTypeMemo[T.getTypePtr()] = QualType(RT, 0);
     return QualType(RT, 0);
+  }
 
   const auto *InnerRef = T->getAs<ReferenceType>();
 
@@ -2933,6 +2990,8 @@ ASTContext::getLValueReferenceType(QualType T, bool SpelledAsLValue) const {
                                                              SpelledAsLValue);
   Types.push_back(New);
   LValueReferenceTypes.InsertNode(New, InsertPos);
+  if (Memoizable)
+    LValueReferenceTypeMemo[T.getTypePtr()] = QualType(New, 0);
 
   return QualType(New, 0);
 }
@@ -2940,6 +2999,16 @@ ASTContext::getLValueReferenceType(QualType T, bool SpelledAsLValue) const {
 /// getRValueReferenceType - Return the uniqued reference to the type for an
 /// rvalue reference to the specified type.
 QualType ASTContext::getRValueReferenceType(QualType T) const {
+  bool Memoizable = !T.hasLocalQualifiers();
+  if (Memoizable) {
+    auto Memo = RValueReferenceTypeMemo.find(T.getTypePtr());
+    if (Memo != RValueReferenceTypeMemo.end()) {
+      ++NumTypeMemoHits;
+      return Memo->second;
+    }
+    ++NumTypeMemoMisses;
+  }
+
   // Unique pointers, to guarantee there is only one pointer of a particular
   // structure.
   llvm::FoldingSetNodeID ID;
@@ -2947,8 +3016,11 @@ QualType ASTContext::getRValueReferenceType(QualType T) const {
 
   void *InsertPos = nullptr;
   if (RValueReferenceType *RT =
-        RValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos))
+        RValueReferenceTypes.FindNodeOrInsertPos(ID, InsertPos)) {
+    if (Memoizable)
+      RValueReferenceTypeMemo[T.getTypePtr()] = QualType(RT, 0);
     return QualType(RT, 0);
+  }
 
   const auto *InnerRef = T->getAs<ReferenceType>();
 
@@ -2968,6 +3040,8 @@ QualType ASTContext::getRValueReferenceType(QualType T) const {
   auto *New = new (*this, TypeAlignment) RValueReferenceType(T, Canonical);
   Types.push_back(New);
   RValueReferenceTypes.InsertNode(New, InsertPos);
+  if (Memoizable)
+    RValueReferenceTypeMemo[T.getTypePtr()] = QualType(New, 0);
   return QualType(New, 0);
 }
 
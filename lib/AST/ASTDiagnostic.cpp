@@ -231,8 +231,10 @@ ConvertTypeToDiagnosticString(ASTContext &Context, QualType Ty,
   // FIXME: Playing with std::string is really slow.
   bool ForceAKA = false;
   QualType CanTy = Ty.getCanonicalType();
-  std::string S = Ty.getAsString(Context.getPrintingPolicy());
-  std::string CanS = CanTy.getAsString(Context.getPrintingPolicy());
+  // Type names are memoized in the context; diagnostic cascades (overload
+  // resolution notes in particular) print the same types repeatedly.
+  std::string S = Context.getCachedTypeName(Ty).str();
+  StringRef CanS = Context.getCachedTypeName(CanTy);
 
   for (unsigned I = 0, E = QualTypeVals.size(); I != E; ++I) {
     QualType CompareTy =
@@ -244,16 +246,14 @@ ConvertTypeToDiagnosticString(ASTContext &Context, QualType Ty,
     QualType CompareCanTy = CompareTy.getCanonicalType();
     if (CompareCanTy == CanTy)
       continue;  // Same canonical types
-    std::string CompareS = CompareTy.getAsString(Context.getPrintingPolicy());
+    StringRef CompareS = Context.getCachedTypeName(CompareTy);
     bool ShouldAKA = false;
     QualType CompareDesugar = Desugar(Context, CompareTy, ShouldAKA);
-    std::string CompareDesugarStr =
-        CompareDesugar.getAsString(Context.getPrintingPolicy());
+    StringRef CompareDesugarStr = Context.getCachedTypeName(CompareDesugar);
     if (CompareS != S && CompareDesugarStr != S)
       continue;  // The type string is different than the comparison string
                  // and the desugared comparison string.
-    std::string CompareCanS =
-        CompareCanTy.getAsString(Context.getPrintingPolicy());
+    StringRef CompareCanS = Context.getCachedTypeName(CompareCanTy);
 
     if (CompareCanS == CanS)
       continue;  // No new info from canonical type
@@ -286,9 +286,9 @@ ConvertTypeToDiagnosticString(ASTContext &Context, QualType Ty,
       if (DesugaredTy == Ty) {
         DesugaredTy = Ty.getCanonicalType();
       }
-      std::string akaStr = DesugaredTy.getAsString(Context.getPrintingPolicy());
+      StringRef akaStr = Context.getCachedTypeName(DesugaredTy);
       if (akaStr != S) {
-        S = "'" + S + "' (aka '" + akaStr + "')";
+        S = "'" + S + "' (aka '" + akaStr.str() + "')";
         return S;
       }
     }
@@ -302,8 +302,8 @@ ConvertTypeToDiagnosticString(ASTContext &Context, QualType Ty,
       llvm::raw_string_ostream OS(DecoratedString);
       const char *Values = VTy->getNumElements() > 1 ? "values" : "value";
       OS << "'" << S << "' (vector of " << VTy->getNumElements() << " '"
-         << VTy->getElementType().getAsString(Context.getPrintingPolicy())
-         << "' " << Values << ")";
+         << Context.getCachedTypeName(VTy->getElementType()) << "' " << Values
+         << ")";
       return OS.str();
     }
   }
@@ -20,8 +20,10 @@
 #include "clang/AST/RecordLayout.h"
 #include "clang/AST/TemplateName.h"
 #include "clang/AST/Type.h"
+#include "clang/Basic/IdentifierTable.h"
 #include "clang/Basic/LLVM.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
@@ -340,6 +342,101 @@ bool CXXBasePaths::lookupInBases(ASTContext &Context,
   return FoundPath;
 }
 
+/// Set the filter bits for one identifier.  The IdentifierInfo pointer is
+/// uniqued per identifier table, so hashing the pointer is stable for the
+/// lifetime of the ASTContext.
+static void addNameToFilter(ASTContext::MemberNameFilter &F,
+                            const IdentifierInfo *II) {
+  uint64_t Hash = llvm::hash_value(static_cast<const void *>(II));
+  unsigned Bit1 = Hash & 511;
+  unsigned Bit2 = (Hash >> 9) & 511;
+  F.Bits[Bit1 / 64] |= uint64_t(1) << (Bit1 % 64);
+  F.Bits[Bit2 / 64] |= uint64_t(1) << (Bit2 % 64);
+}
+
+/// Fold the identifier member names of \p RD and its transitive bases into
+/// \p F.  Returns false if the hierarchy cannot be soundly filtered.
+static bool collectMemberNames(const ASTContext &Context,
+                               const CXXRecordDecl *RD,
+                               ASTContext::MemberNameFilter &F) {
+  const CXXRecordDecl *Def = RD->getDefinition();
+  // The member set must be closed: a definition that is still being parsed,
+  // is dependent, or can have names materialized by an external AST source
+  // may grow identifiers after the filter is built.
+  if (!Def || Def->isBeingDefined() || Def->isDependentContext() ||
+      Def->hasExternalLexicalStorage() || Def->hasExternalVisibleStorage())
+    return false;
+
+  for (const Decl *D : Def->decls()) {
+    if (const auto *ND = dyn_cast<NamedDecl>(D))
+      if (const IdentifierInfo *II = ND->getDeclName().getAsIdentifierInfo())
+        addNameToFilter(F, II);
+    // Unscoped enumerations are transparent contexts; their enumerators are
+    // members of the class for lookup purposes but not lexical children.
+    if (const auto *ED = dyn_cast<EnumDecl>(D))
+      if (!ED->isScoped())
+        for (const EnumConstantDecl *ECD : ED->enumerators())
+          if (const IdentifierInfo *II = ECD->getIdentifier())
+            addNameToFilter(F, II);
+  }
+
+  for (const CXXBaseSpecifier &Base : Def->bases()) {
+    const auto *BaseRecord = Base.getType()->getAsCXXRecordDecl();
+    if (!BaseRecord)
+      return false;
+    const ASTContext::MemberNameFilter *BaseFilter =
+        Context.getMemberNameFilter(BaseRecord);
+    if (!BaseFilter)
+      return false;
+    for (unsigned I = 0; I != 8; ++I)
+      F.Bits[I] |= BaseFilter->Bits[I];
+  }
+
+  return true;
+}
+
+const ASTContext::MemberNameFilter *
+ASTContext::getMemberNameFilter(const CXXRecordDecl *RD) const {
+  const CXXRecordDecl *Key = RD->getDefinition();
+  if (!Key)
+    return nullptr;
+
+  auto Known = MemberNameFilters.find(Key);
+  if (Known != MemberNameFilters.end())
+    return Known->second.Valid ? &Known->second : nullptr;
+
+  // Build into a local first: collecting base filters recurses into this
+  // function and may grow the map.
+  MemberNameFilter F;
+  F.Valid = collectMemberNames(*this, Key, F);
+
+  MemberNameFilter &Entry = MemberNameFilters[Key];
+  Entry = F;
+  return Entry.Valid ? &Entry : nullptr;
+}
+
+bool CXXRecordDecl::mayContainMemberName(DeclarationName Name) const {
+  const IdentifierInfo *II = Name.getAsIdentifierInfo();
+  if (!II)
+    return true;
+
+  ASTContext &Context = getASTContext();
+  const ASTContext::MemberNameFilter *F = Context.getMemberNameFilter(this);
+  if (!F)
+    return true;
+
+  ++Context.NumMemberNameFilterQueries;
+  uint64_t Hash = llvm::hash_value(static_cast<const void *>(II));
+  unsigned Bit1 = Hash & 511;
+  unsigned Bit2 = (Hash >> 9) & 511;
+  if ((F->Bits[Bit1 / 64] & (uint64_t(1) << (Bit1 % 64))) &&
+      (F->Bits[Bit2 / 64] & (uint64_t(1) << (Bit2 % 64))))
+    return true;
+
+  ++Context.NumMemberNameFilterRejections;
+  return false;
+}
+
 bool CXXRecordDecl::lookupInBases(BaseMatchesCallback BaseMatches,
                                   CXXBasePaths &Paths,
                                   bool LookupInDependent) const {
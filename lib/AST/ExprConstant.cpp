@@ -44,6 +44,7 @@
 #include "clang/AST/TypeLoc.h"
 #include "clang/Basic/Builtins.h"
 #include "clang/Basic/TargetInfo.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cstring>
 #include <functional>
@@ -10704,6 +10705,211 @@ static bool EvaluateAsRValue(EvalInfo &Info, const Expr *E, APValue &Result) {
   return CheckConstantExpression(Info, E->getExprLoc(), E->getType(), Result);
 }
 
+STATISTIC(NumFastIntEvaluations,
+          "Number of integer evaluations taking the fast tier");
+STATISTIC(NumSlowIntEvaluations,
+          "Number of integer evaluations taking the full evaluator");
+
+namespace {
+
+/// A bounded, allocation-free evaluator for small integer expression trees:
+/// literals, enum constants, integral casts and the common arithmetic,
+/// shift, comparison and logical operators.  Array bounds, case labels and
+/// enumerator values are overwhelmingly of this shape, and routing them
+/// through the full evaluator pays for EvalInfo setup on every call.
+///
+/// The fast tier must be invisible: it only folds what the full evaluator
+/// would fold to the same value without emitting any diagnostic.  Anything
+/// it is not sure about -- signed overflow, division by zero, out-of-range
+/// shifts, widths over 64 bits, unknown node kinds -- makes it bail so the
+/// full evaluator can produce the authoritative result and notes.
+class FastIntExprEvaluator {
+  const ASTContext &Ctx;
+  unsigned StepsLeft = 64;
+
+public:
+  FastIntExprEvaluator(const ASTContext &Ctx) : Ctx(Ctx) {}
+
+  bool evaluate(const Expr *E, APSInt &Result);
+};
+
+bool FastIntExprEvaluator::evaluate(const Expr *E, APSInt &Result) {
+  if (StepsLeft == 0)
+    return false;
+  --StepsLeft;
+
+  QualType T = E->getType();
+  if (T.isNull() || !T->isIntegralOrEnumerationType())
+    return false;
+  unsigned Width = Ctx.getIntWidth(T);
+  // Stay within APInt's inline storage; wider types are rare here.
+  if (Width > 64)
+    return false;
+  bool Unsigned = T->isUnsignedIntegerOrEnumerationType();
+
+  switch (E->getStmtClass()) {
+  case Stmt::IntegerLiteralClass:
+    Result = APSInt(cast<IntegerLiteral>(E)->getValue(), Unsigned);
+    return Result.getBitWidth() == Width;
+
+  case Stmt::CXXBoolLiteralExprClass:
+    Result = APSInt(APInt(Width, cast<CXXBoolLiteralExpr>(E)->getValue()),
+                    /*isUnsigned=*/true);
+    return true;
+
+  case Stmt::CharacterLiteralClass:
+    Result =
+        APSInt(APInt(Width, cast<CharacterLiteral>(E)->getValue()), Unsigned);
+    return true;
+
+  case Stmt::DeclRefExprClass: {
+    const auto *ECD =
+        dyn_cast<EnumConstantDecl>(cast<DeclRefExpr>(E)->getDecl());
+    if (!ECD || ECD->getInitVal().getBitWidth() != Width)
+      return false;
+    Result = APSInt(ECD->getInitVal(), Unsigned);
+    return true;
+  }
+
+  case Stmt::ParenExprClass:
+    return evaluate(cast<ParenExpr>(E)->getSubExpr(), Result);
+
+  case Stmt::ConstantExprClass:
+    return evaluate(cast<ConstantExpr>(E)->getSubExpr(), Result);
+
+  case Stmt::ImplicitCastExprClass: {
+    const auto *CE = cast<ImplicitCastExpr>(E);
+    APSInt Sub;
+    switch (CE->getCastKind()) {
+    case CK_IntegralToBoolean:
+      if (!evaluate(CE->getSubExpr(), Sub))
+        return false;
+      Result = APSInt(APInt(Width, Sub != 0), /*isUnsigned=*/true);
+      return true;
+    case CK_NoOp:
+    case CK_IntegralCast:
+      if (!evaluate(CE->getSubExpr(), Sub))
+        return false;
+      // Extension follows the *source* signedness carried by Sub.
+      Result = APSInt(Sub.extOrTrunc(Width), Unsigned);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  case Stmt::UnaryOperatorClass: {
+    const auto *UO = cast<UnaryOperator>(E);
+    APSInt Sub;
+    switch (UO->getOpcode()) {
+    case UO_Plus:
+      return evaluate(UO->getSubExpr(), Result);
+    case UO_Minus:
+      if (!evaluate(UO->getSubExpr(), Sub) || Sub.getBitWidth() != Width ||
+          (!Unsigned && Sub.isMinSignedValue()))
+        return false;
+      Result = -Sub;
+      return true;
+    case UO_Not:
+      if (!evaluate(UO->getSubExpr(), Sub) || Sub.getBitWidth() != Width)
+        return false;
+      Result = ~Sub;
+      return true;
+    case UO_LNot:
+      if (!evaluate(UO->getSubExpr(), Sub))
+        return false;
+      Result = APSInt(APInt(Width, Sub == 0), Unsigned);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  case Stmt::BinaryOperatorClass: {
+    const auto *BO = cast<BinaryOperator>(E);
+    APSInt L, R;
+    if (!evaluate(BO->getLHS(), L) || !evaluate(BO->getRHS(), R))
+      return false;
+
+    // Comparisons and logical operators consume operands of a common type
+    // that need not match E's type; everything else is homogeneous.
+    switch (BO->getOpcode()) {
+    case BO_LT: case BO_GT: case BO_LE: case BO_GE:
+    case BO_EQ: case BO_NE:
+    case BO_LAnd: case BO_LOr:
+      if (L.getBitWidth() != R.getBitWidth() ||
+          L.isUnsigned() != R.isUnsigned())
+        return false;
+      break;
+    default:
+      if (L.getBitWidth() != Width || R.getBitWidth() != Width)
+        return false;
+      break;
+    }
+
+    bool Overflow = false;
+    switch (BO->getOpcode()) {
+    case BO_Add:
+      Result = Unsigned ? L + R : APSInt(L.sadd_ov(R, Overflow), Unsigned);
+      break;
+    case BO_Sub:
+      Result = Unsigned ? L - R : APSInt(L.ssub_ov(R, Overflow), Unsigned);
+      break;
+    case BO_Mul:
+      Result = Unsigned ? L * R : APSInt(L.smul_ov(R, Overflow), Unsigned);
+      break;
+    case BO_Div:
+    case BO_Rem:
+      if (R == 0 || (!Unsigned && L.isMinSignedValue() && R.isAllOnesValue()))
+        return false;
+      Result = BO->getOpcode() == BO_Div ? L / R : L % R;
+      break;
+    case BO_And: Result = L & R; break;
+    case BO_Or:  Result = L | R; break;
+    case BO_Xor: Result = L ^ R; break;
+    case BO_Shl:
+    case BO_Shr:
+      if (R.isSigned() && R.isNegative())
+        return false;
+      if (R.uge(Width))
+        return false;
+      if (BO->getOpcode() == BO_Shl) {
+        // Leave any form of shift overflow (including shifting into or past
+        // the sign bit) to the full evaluator and its diagnostics.
+        Result = Unsigned
+                     ? APSInt(L.ushl_ov(R, Overflow), Unsigned)
+                     : APSInt(L.sshl_ov(R, Overflow), Unsigned);
+        if (!Unsigned && L.isNegative())
+          return false;
+      } else {
+        Result = L >> unsigned(R.getZExtValue());
+      }
+      break;
+    case BO_LT: Result = APSInt(APInt(Width, L < R), Unsigned); break;
+    case BO_GT: Result = APSInt(APInt(Width, L > R), Unsigned); break;
+    case BO_LE: Result = APSInt(APInt(Width, L <= R), Unsigned); break;
+    case BO_GE: Result = APSInt(APInt(Width, L >= R), Unsigned); break;
+    case BO_EQ: Result = APSInt(APInt(Width, L == R), Unsigned); break;
+    case BO_NE: Result = APSInt(APInt(Width, L != R), Unsigned); break;
+    case BO_LAnd:
+      Result = APSInt(APInt(Width, L != 0 && R != 0), Unsigned);
+      break;
+    case BO_LOr:
+      Result = APSInt(APInt(Width, L != 0 || R != 0), Unsigned);
+      break;
+    default:
+      return false;
+    }
+    return !Overflow;
+  }
+
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
 static bool FastEvaluateAsRValue(const Expr *Exp, Expr::EvalResult &Result,
                                  const ASTContext &Ctx, bool &IsConst) {
   // Fast-path evaluations of integer literals, since we sometimes see files
@@ -10715,6 +10921,23 @@ static bool FastEvaluateAsRValue(const Expr *Exp, Expr::EvalResult &Result,
     return true;
   }
 
+  // Likewise for bool and character literals; these are common as branch
+  // conditions and as arguments of heavily-instantiated templates.
+  if (const CXXBoolLiteralExpr *L = dyn_cast<CXXBoolLiteralExpr>(Exp)) {
+    Result.Val =
+        APValue(APSInt(APInt(Ctx.getIntWidth(L->getType()), L->getValue()),
+                       /*isUnsigned=*/true));
+    IsConst = true;
+    return true;
+  }
+  if (const CharacterLiteral *L = dyn_cast<CharacterLiteral>(Exp)) {
+    Result.Val =
+        APValue(APSInt(APInt(Ctx.getIntWidth(L->getType()), L->getValue()),
+                       L->getType()->isUnsignedIntegerOrEnumerationType()));
+    IsConst = true;
+    return true;
+  }
+
   // This case should be rare, but we need to check it before we check on
   // the type below.
   if (Exp->getType().isNull()) {
@@ -10730,6 +10953,19 @@ static bool FastEvaluateAsRValue(const Expr *Exp, Expr::EvalResult &Result,
     IsConst = false;
     return true;
   }
+
+  // Try a bounded walk over small integer expression trees before paying for
+  // EvalInfo setup in the full evaluator.
+  if (Exp->isRValue() && Exp->getType()->isIntegralOrEnumerationType()) {
+    APSInt Value;
+    if (FastIntExprEvaluator(Ctx).evaluate(Exp, Value)) {
+      ++NumFastIntEvaluations;
+      Result.Val = APValue(Value);
+      IsConst = true;
+      return true;
+    }
+    ++NumSlowIntEvaluations;
+  }
   return false;
 }
 
@@ -80,6 +80,11 @@ bool ExternalASTSource::layoutRecordType(
   return false;
 }
 
+bool ExternalASTSource::getImportedRecordLayout(const RecordDecl *Record,
+                                                ImportedRecordLayout &Layout) {
+  return false;
+}
+
 Decl *ExternalASTSource::GetExternalDecl(uint32_t ID) {
   return nullptr;
 }
@@ -2959,6 +2959,71 @@ void MicrosoftRecordLayoutBuilder::computeVtorDispSet(
   }
 }
 
+const ASTRecordLayout *
+ASTContext::loadImportedRecordLayout(const RecordDecl *D) const {
+  ExternalASTSource::ImportedRecordLayout Imported;
+  if (!getExternalSource()->getImportedRecordLayout(D, Imported))
+    return nullptr;
+
+  if (!Imported.IsCXX)
+    return new (*this) ASTRecordLayout(
+        *this, Imported.Size, Imported.Alignment, Imported.UnadjustedAlignment,
+        Imported.RequiredAlignment, Imported.DataSize, Imported.FieldOffsets);
+
+  ASTRecordLayout::BaseOffsetsMapTy Bases;
+  for (const auto &B : Imported.Bases)
+    Bases[B.Base] = B.Offset;
+  ASTRecordLayout::VBaseOffsetsMapTy VBases;
+  for (const auto &B : Imported.VBases)
+    VBases[B.Base] = ASTRecordLayout::VBaseInfo(B.Offset, B.HasVtorDisp);
+
+  return new (*this) ASTRecordLayout(
+      *this, Imported.Size, Imported.Alignment, Imported.UnadjustedAlignment,
+      Imported.RequiredAlignment, Imported.HasOwnVFPtr,
+      Imported.HasExtendableVFPtr, Imported.VBPtrOffset, Imported.DataSize,
+      Imported.FieldOffsets, Imported.NonVirtualSize,
+      Imported.NonVirtualAlignment, Imported.SizeOfLargestEmptySubobject,
+      Imported.PrimaryBase, Imported.PrimaryBaseIsVirtual,
+      Imported.BaseSharingVBPtr, Imported.EndsWithZeroSizedObject,
+      Imported.LeadsWithZeroSizedBase, Bases, VBases);
+}
+
+/// Compare an imported record layout against a freshly computed one and
+/// report any disagreement; used under -fverify-record-layouts.
+static void checkImportedRecordLayout(const RecordDecl *D,
+                                      const ASTRecordLayout &Imported,
+                                      const ASTRecordLayout &Computed) {
+  auto Complain = [&](const char *What) {
+    llvm::errs() << "*** Imported record layout mismatch (" << What << ") for ";
+    D->printQualifiedName(llvm::errs());
+    llvm::errs() << "\n";
+  };
+
+  if (Imported.getSize() != Computed.getSize())
+    Complain("size");
+  if (Imported.getDataSize() != Computed.getDataSize())
+    Complain("data size");
+  if (Imported.getAlignment() != Computed.getAlignment())
+    Complain("alignment");
+  if (Imported.getFieldCount() != Computed.getFieldCount()) {
+    Complain("field count");
+  } else {
+    for (unsigned I = 0, N = Computed.getFieldCount(); I != N; ++I)
+      if (Imported.getFieldOffset(I) != Computed.getFieldOffset(I)) {
+        Complain("field offset");
+        break;
+      }
+  }
+  if (isa<CXXRecordDecl>(D)) {
+    if (Imported.getNonVirtualSize() != Computed.getNonVirtualSize())
+      Complain("non-virtual size");
+    if (Imported.getNonVirtualAlignment() != Computed.getNonVirtualAlignment())
+      Complain("non-virtual alignment");
+    if (Imported.getPrimaryBase() != Computed.getPrimaryBase())
+      Complain("primary base");
+  }
+}
+
 /// getASTRecordLayout - Get or compute information about the layout of the
 /// specified record (struct/union/class), which indicates its size and field
 /// position information.
@@ -2983,6 +3048,22 @@ ASTContext::getASTRecordLayout(const RecordDecl *D) const {
   const ASTRecordLayout *Entry = ASTRecordLayouts[D];
   if (Entry) return *Entry;
 
+  // If the definition was deserialized from an AST file that recorded the
+  // layout it computed, reuse that result instead of running the builder.
+  // Under -fverify-record-layouts we compute the layout anyway and compare.
+  const ASTRecordLayout *ImportedEntry = nullptr;
+  if (getExternalSource() && D->isFromASTFile()) {
+    ImportedEntry = loadImportedRecordLayout(D);
+    if (ImportedEntry && !getLangOpts().VerifyImportedRecordLayouts) {
+      ASTRecordLayouts[D] = ImportedEntry;
+      if (getLangOpts().DumpRecordLayouts) {
+        llvm::outs() << "\n*** Dumping AST Record Layout\n";
+        DumpRecordLayout(D, llvm::outs(), getLangOpts().DumpRecordLayoutsSimple);
+      }
+      return *ImportedEntry;
+    }
+  }
+
   const ASTRecordLayout *NewEntry = nullptr;
 
   if (isMsLayout(*this)) {
@@ -3042,6 +3123,9 @@ ASTContext::getASTRecordLayout(const RecordDecl *D) const {
     }
   }
 
+  if (ImportedEntry)
+    checkImportedRecordLayout(D, *ImportedEntry, *NewEntry);
+
   ASTRecordLayouts[D] = NewEntry;
 
   if (getLangOpts().DumpRecordLayouts) {
@@ -119,6 +119,7 @@ void DiagnosticsEngine::Reset() {
 
   NumWarnings = 0;
   NumErrors = 0;
+  NumSuppressed = 0;
   TrapNumErrorsOccurred = 0;
   TrapNumUnrecoverableErrorsOccurred = 0;
 
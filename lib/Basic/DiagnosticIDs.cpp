@@ -478,8 +478,8 @@ DiagnosticIDs::getDiagnosticSeverity(unsigned DiagID, SourceLocation Loc,
   }
 
   // Custom diagnostics always are emitted in system headers.
-  bool ShowInSystemHeader =
-      !GetDiagInfo(DiagID) || GetDiagInfo(DiagID)->WarnShowInSystemHeader;
+  const StaticDiagInfoRec *Rec = GetDiagInfo(DiagID);
+  bool ShowInSystemHeader = !Rec || Rec->WarnShowInSystemHeader;
 
   // If we are in a system header, we ignore it. We look at the diagnostic class
   // because we also want to ignore extensions and warnings in -Werror and
@@ -669,8 +669,10 @@ bool DiagnosticIDs::ProcessDiag(DiagnosticsEngine &Diag) const {
   // a note and the last real diagnostic was ignored, ignore it too.
   if (DiagLevel == DiagnosticIDs::Ignored ||
       (DiagLevel == DiagnosticIDs::Note &&
-       Diag.LastDiagLevel == DiagnosticIDs::Ignored))
+       Diag.LastDiagLevel == DiagnosticIDs::Ignored)) {
+    ++Diag.NumSuppressed;
     return false;
+  }
 
   if (DiagLevel >= DiagnosticIDs::Error) {
     if (isUnrecoverable(DiagID))
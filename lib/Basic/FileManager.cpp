@@ -427,7 +427,8 @@ bool FileManager::makeAbsolutePath(SmallVectorImpl<char> &Path) const {
 
 llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
 FileManager::getBufferForFile(const FileEntry *Entry, bool isVolatile,
-                              bool ShouldCloseOpenFile) {
+                              bool ShouldCloseOpenFile,
+                              bool RequiresNullTerminator) {
   uint64_t FileSize = Entry->getSize();
   // If there's a high enough chance that the file have changed since we
   // got its size, force a stat before opening it.
@@ -437,9 +438,8 @@ FileManager::getBufferForFile(const FileEntry *Entry, bool isVolatile,
   StringRef Filename = Entry->getName();
   // If the file is already open, use the open file descriptor.
   if (Entry->File) {
-    auto Result =
-        Entry->File->getBuffer(Filename, FileSize,
-                               /*RequiresNullTerminator=*/true, isVolatile);
+    auto Result = Entry->File->getBuffer(Filename, FileSize,
+                                         RequiresNullTerminator, isVolatile);
     // FIXME: we need a set of APIs that can make guarantees about whether a
     // FileEntry is open or not.
     if (ShouldCloseOpenFile)
@@ -450,13 +450,13 @@ FileManager::getBufferForFile(const FileEntry *Entry, bool isVolatile,
   // Otherwise, open the file.
 
   if (FileSystemOpts.WorkingDir.empty())
-    return FS->getBufferForFile(Filename, FileSize,
-                                /*RequiresNullTerminator=*/true, isVolatile);
+    return FS->getBufferForFile(Filename, FileSize, RequiresNullTerminator,
+                                isVolatile);
 
   SmallString<128> FilePath(Entry->getName());
   FixupRelativePath(FilePath);
-  return FS->getBufferForFile(FilePath, FileSize,
-                              /*RequiresNullTerminator=*/true, isVolatile);
+  return FS->getBufferForFile(FilePath, FileSize, RequiresNullTerminator,
+                              isVolatile);
 }
 
 llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
@@ -529,6 +529,16 @@ void FileManager::GetUniqueIDMapping(
       UIDToFiles[VFE->getUID()] = VFE.get();
 }
 
+void FileManager::forEachSeenFileEntry(
+    llvm::function_ref<void(StringRef, const FileEntry *)> Visit) const {
+  for (const auto &Entry : SeenFileEntries) {
+    const FileEntry *FE = Entry.getValue();
+    if (FE == NON_EXISTENT_FILE)
+      FE = nullptr;
+    Visit(Entry.getKey(), FE);
+  }
+}
+
 void FileManager::modifyFileEntry(FileEntry *File,
                                   off_t Size, time_t ModificationTime) {
   File->Size = Size;
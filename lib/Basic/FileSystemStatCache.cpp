@@ -110,6 +110,39 @@ bool FileSystemStatCache::get(StringRef Path, FileData &Data, bool isFile,
   return false;
 }
 
+DirectoryScanStatCache::LookupResult
+DirectoryScanStatCache::getStat(StringRef Path, FileData &Data, bool isFile,
+                                std::unique_ptr<llvm::vfs::File> *F,
+                                llvm::vfs::FileSystem &FS) {
+  // Only short-circuit file lookups; directory lookups are rare enough (one
+  // per search path) that they are not worth the listing.
+  StringRef Dir = llvm::sys::path::parent_path(Path);
+  if (!isFile || Dir.empty())
+    return statChained(Path, Data, isFile, F, FS);
+
+  auto Scanned = DirEntries.find(Dir);
+  if (Scanned == DirEntries.end()) {
+    llvm::Optional<llvm::StringSet<>> &Listing =
+        DirEntries[Dir] = llvm::StringSet<>();
+    std::error_code EC;
+    for (llvm::vfs::directory_iterator I = FS.dir_begin(Dir, EC), E;
+         !EC && I != E; I.increment(EC))
+      Listing->insert(llvm::sys::path::filename(I->path()));
+    if (EC) {
+      // The directory is unreadable (or not a directory); remember that and
+      // always fall through for paths below it.
+      Listing = llvm::None;
+    }
+    Scanned = DirEntries.find(Dir);
+  }
+
+  if (Scanned->second.hasValue() &&
+      !Scanned->second->count(llvm::sys::path::filename(Path)))
+    return CacheMissing;
+
+  return statChained(Path, Data, isFile, F, FS);
+}
+
 MemorizeStatCalls::LookupResult
 MemorizeStatCalls::getStat(StringRef Path, FileData &Data, bool isFile,
                            std::unique_ptr<llvm::vfs::File> *F,
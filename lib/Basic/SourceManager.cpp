@@ -349,6 +349,8 @@ void SourceManager::clearIDTables() {
   LastLineNoFileIDQuery = FileID();
   LastLineNoContentCache = nullptr;
   LastFileIDLookup = FileID();
+  for (FileID &Recent : RecentFileIDLookups)
+    Recent = FileID();
 
   if (LineTable)
     LineTable->clear();
@@ -562,7 +564,8 @@ FileID SourceManager::createFileID(const ContentCache *File,
   // Set LastFileIDLookup to the newly created file.  The next getFileID call is
   // almost guaranteed to be from that file.
   FileID FID = FileID::get(LocalSLocEntryTable.size()-1);
-  return LastFileIDLookup = FID;
+  rememberFileIDLookup(FID);
+  return FID;
 }
 
 SourceLocation
@@ -748,7 +751,7 @@ FileID SourceManager::getFileIDLocal(unsigned SLocOffset) const {
       // If this isn't an expansion, remember it.  We have good locality across
       // FileID lookups.
       if (!I->isExpansion())
-        LastFileIDLookup = Res;
+        rememberFileIDLookup(Res);
       NumLinearScans += NumProbes+1;
       return Res;
     }
@@ -789,7 +792,7 @@ FileID SourceManager::getFileIDLocal(unsigned SLocOffset) const {
       // If this isn't a macro expansion, remember it.  We have good locality
       // across FileID lookups.
       if (!LocalSLocEntryTable[MiddleIndex].isExpansion())
-        LastFileIDLookup = Res;
+        rememberFileIDLookup(Res);
       NumBinaryProbes += NumProbes;
       return Res;
     }
@@ -829,7 +832,7 @@ FileID SourceManager::getFileIDLoaded(unsigned SLocOffset) const {
       FileID Res = FileID::get(-int(I) - 2);
 
       if (!E.isExpansion())
-        LastFileIDLookup = Res;
+        rememberFileIDLookup(Res);
       NumLinearScans += NumProbes + 1;
       return Res;
     }
@@ -863,7 +866,7 @@ FileID SourceManager::getFileIDLoaded(unsigned SLocOffset) const {
     if (isOffsetInFileID(FileID::get(-int(MiddleIndex) - 2), SLocOffset)) {
       FileID Res = FileID::get(-int(MiddleIndex) - 2);
       if (!E.isExpansion())
-        LastFileIDLookup = Res;
+        rememberFileIDLookup(Res);
       NumBinaryProbes += NumProbes;
       return Res;
     }
@@ -1194,6 +1197,8 @@ unsigned SourceManager::getPresumedColumnNumber(SourceLocation Loc,
 
 #ifdef __SSE2__
 #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 static LLVM_ATTRIBUTE_NOINLINE void
@@ -1250,12 +1255,32 @@ static void ComputeLineNumbers(DiagnosticsEngine &Diag, ContentCache *FI,
       }
       NextBuf += 16;
     }
+#elif defined(__ARM_NEON)
+    // Same idea as the SSE2 path above.  NEON has no movemask, so narrow the
+    // byte-wise comparison result to a 64-bit mask carrying four bits per
+    // lane and count trailing zeros in that instead.  Unaligned loads are
+    // cheap here, so no alignment prologue is needed.
+    const uint8x16_t CRs = vdupq_n_u8('\r');
+    const uint8x16_t LFs = vdupq_n_u8('\n');
+
+    while (NextBuf+16 <= End) {
+      const uint8x16_t Chunk = vld1q_u8(NextBuf);
+      uint8x16_t Cmp = vorrq_u8(vceqq_u8(Chunk, CRs), vceqq_u8(Chunk, LFs));
+      uint64_t Mask = vget_lane_u64(
+          vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Cmp), 4)), 0);
+
+      if (Mask != 0) {
+        NextBuf += llvm::countTrailingZeros(Mask) / 4;
+        goto FoundSpecialChar;
+      }
+      NextBuf += 16;
+    }
 #endif
 
     while (*NextBuf != '\n' && *NextBuf != '\r' && *NextBuf != '\0')
       ++NextBuf;
 
-#ifdef __SSE2__
+#if defined(__SSE2__) || defined(__ARM_NEON)
 FoundSpecialChar:
 #endif
     Offs += NextBuf-Buf;
@@ -2164,7 +2189,8 @@ void SourceManager::PrintStats() const {
                << NumLineNumsComputed << " files with line #'s computed, "
                << NumMacroArgsComputed << " files with macro args computed.\n";
   llvm::errs() << "FileID scans: " << NumLinearScans << " linear, "
-               << NumBinaryProbes << " binary.\n";
+               << NumBinaryProbes << " binary, " << NumRecentCacheHits
+               << " recent-file cache hits.\n";
 }
 
 LLVM_DUMP_METHOD void SourceManager::dump() const {
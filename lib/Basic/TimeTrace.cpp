@@ -0,0 +1,287 @@
+//===- TimeTrace.cpp - Hierarchical time profiler -------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the -ftime-trace profiler declared in TimeTrace.h.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/TimeTrace.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace clang;
+
+// Hardware counters answer what wall time cannot: whether a regression is
+// more instructions, worse caching or worse prediction.  When enabled (and
+// supported), each trace event carries the counter deltas accumulated while
+// it was the innermost open event's subtree, i.e. over its whole duration.
+static llvm::cl::opt<bool> TimeTracePerfCounters(
+    "time-trace-perf-counters", llvm::cl::Hidden,
+    llvm::cl::desc("Attach hardware performance counter deltas (instructions, "
+                   "cycles, cache-misses, branch-misses) to -ftime-trace "
+                   "events (Linux only; needs perf_event_open access)"));
+
+namespace {
+
+using ClockTy = std::chrono::steady_clock;
+using DurationTy = std::chrono::duration<ClockTy::rep, ClockTy::period>;
+
+enum { NumPerfCounters = 4 };
+
+// JSON keys, index-matched to the configs below; kept unconditional so the
+// writer compiles on every host.
+const char *const PerfCounterNames[NumPerfCounters] = {
+    "instructions", "cycles", "cache-misses", "branch-misses"};
+
+struct PerfCounterValues {
+  uint64_t Values[NumPerfCounters] = {};
+};
+
+/// Per-process hardware counters read around each trace event.  All four are
+/// opened or none are, so every emitted event has the same columns; any
+/// failure (no PMU, perf_event_paranoid, non-Linux host) silently leaves the
+/// group disabled and the trace output identical to an uninstrumented run.
+class PerfCounterGroup {
+  int FDs[NumPerfCounters];
+  bool Enabled = false;
+
+public:
+  PerfCounterGroup() {
+    for (int &FD : FDs)
+      FD = -1;
+#ifdef __linux__
+    if (!TimeTracePerfCounters)
+      return;
+    static const struct {
+      uint32_t Type;
+      uint64_t Config;
+    } Configs[NumPerfCounters] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    for (unsigned I = 0; I != NumPerfCounters; ++I) {
+      struct perf_event_attr Attr;
+      std::memset(&Attr, 0, sizeof(Attr));
+      Attr.size = sizeof(Attr);
+      Attr.type = Configs[I].Type;
+      Attr.config = Configs[I].Config;
+      Attr.exclude_kernel = 1;
+      Attr.exclude_hv = 1;
+      FDs[I] = (int)syscall(__NR_perf_event_open, &Attr, /*pid=*/0, /*cpu=*/-1,
+                            /*group_fd=*/-1, /*flags=*/0UL);
+      if (FDs[I] < 0) {
+        close();
+        return;
+      }
+    }
+    Enabled = true;
+#endif
+  }
+
+  ~PerfCounterGroup() { close(); }
+
+  bool enabled() const { return Enabled; }
+
+  PerfCounterValues read() const {
+    PerfCounterValues V;
+#ifdef __linux__
+    for (unsigned I = 0; I != NumPerfCounters; ++I) {
+      uint64_t Value = 0;
+      if (::read(FDs[I], &Value, sizeof(Value)) == (ssize_t)sizeof(Value))
+        V.Values[I] = Value;
+    }
+#endif
+    return V;
+  }
+
+private:
+  void close() {
+#ifdef __linux__
+    for (int &FD : FDs) {
+      if (FD >= 0)
+        ::close(FD);
+      FD = -1;
+    }
+#endif
+    Enabled = false;
+  }
+};
+
+struct TimeTraceEntry {
+  ClockTy::time_point Start;
+  DurationTy Duration;
+  std::string Name;
+  std::string Detail;
+  PerfCounterValues StartCounters;
+  PerfCounterValues CounterDeltas;
+
+  TimeTraceEntry(ClockTy::time_point Start, StringRef Name, StringRef Detail)
+      : Start(Start), Duration(DurationTy::zero()), Name(Name),
+        Detail(Detail) {}
+};
+
+} // namespace
+
+namespace clang {
+
+struct TimeTraceProfiler {
+  TimeTraceProfiler() : StartTime(ClockTy::now()) {}
+
+  void begin(StringRef Name, StringRef Detail) {
+    Stack.emplace_back(ClockTy::now(), Name, Detail);
+    if (Counters.enabled())
+      Stack.back().StartCounters = Counters.read();
+  }
+
+  void end() {
+    assert(!Stack.empty() && "timeTraceProfilerEnd without matching begin");
+    TimeTraceEntry E = Stack.pop_back_val();
+    E.Duration = ClockTy::now() - E.Start;
+    if (Counters.enabled()) {
+      PerfCounterValues Now = Counters.read();
+      for (unsigned I = 0; I != NumPerfCounters; ++I)
+        E.CounterDeltas.Values[I] = Now.Values[I] - E.StartCounters.Values[I];
+    }
+
+    // Track total time (and counters) per event name for the per-category
+    // summary blocks, but only for the innermost open event of that name so
+    // recursive instantiations are not double-counted.
+    if (llvm::none_of(Stack, [&](const TimeTraceEntry &Open) {
+          return Open.Name == E.Name;
+        })) {
+      NameTotal &Total = TotalPerName[E.Name];
+      Total.Time += E.Duration;
+      for (unsigned I = 0; I != NumPerfCounters; ++I)
+        Total.Counters.Values[I] += E.CounterDeltas.Values[I];
+    }
+
+    // Only keep events longer than 500us; trace viewers choke on the sheer
+    // number of sub-microsecond events a large TU produces, and they carry
+    // no signal.  Their counters are still folded into the totals above.
+    if (std::chrono::duration_cast<std::chrono::microseconds>(E.Duration)
+            .count() >= 500)
+      Entries.emplace_back(std::move(E));
+  }
+
+  void write(llvm::raw_pwrite_stream &OS) {
+    assert(Stack.empty() &&
+           "All profiler sections should be ended when calling write");
+
+    auto ToUs = [](DurationTy D) {
+      return std::chrono::duration_cast<std::chrono::microseconds>(D).count();
+    };
+
+    bool HaveCounters = Counters.enabled();
+    auto CounterArgs = [&](const PerfCounterValues &V,
+                           llvm::json::Object &Args) {
+      for (unsigned I = 0; I != NumPerfCounters; ++I)
+        Args[PerfCounterNames[I]] = (int64_t)V.Values[I];
+    };
+
+    llvm::json::Array Events;
+    for (const TimeTraceEntry &E : Entries) {
+      llvm::json::Object Event{
+          {"pid", 1},
+          {"tid", 0},
+          {"ph", "X"},
+          {"ts", ToUs(E.Start - StartTime)},
+          {"dur", ToUs(E.Duration)},
+          {"name", E.Name}};
+      llvm::json::Object Args;
+      if (!E.Detail.empty())
+        Args["detail"] = E.Detail;
+      if (HaveCounters)
+        CounterArgs(E.CounterDeltas, Args);
+      if (!Args.empty())
+        Event["args"] = std::move(Args);
+      Events.emplace_back(std::move(Event));
+    }
+
+    // Emit a per-name total as a separate, parallel "thread" so the summary
+    // is visible at the top of the trace viewer.
+    int Tid = 1;
+    for (const auto &Total : TotalPerName) {
+      llvm::json::Object Event{
+          {"pid", 1},
+          {"tid", Tid++},
+          {"ph", "X"},
+          {"ts", 0},
+          {"dur", ToUs(Total.second.Time)},
+          {"name", ("Total " + Total.first()).str()}};
+      if (HaveCounters) {
+        llvm::json::Object Args;
+        CounterArgs(Total.second.Counters, Args);
+        Event["args"] = std::move(Args);
+      }
+      Events.emplace_back(std::move(Event));
+    }
+
+    OS << llvm::formatv("{0:2}", llvm::json::Value(llvm::json::Object{
+                                     {"traceEvents", std::move(Events)}}));
+  }
+
+  struct NameTotal {
+    DurationTy Time = DurationTy::zero();
+    PerfCounterValues Counters;
+  };
+
+  SmallVector<TimeTraceEntry, 16> Stack;
+  std::vector<TimeTraceEntry> Entries;
+  llvm::StringMap<NameTotal> TotalPerName;
+  ClockTy::time_point StartTime;
+  PerfCounterGroup Counters;
+};
+
+static TimeTraceProfiler *TimeTraceProfilerInstance = nullptr;
+
+void timeTraceProfilerInitialize() {
+  assert(TimeTraceProfilerInstance == nullptr &&
+         "Profiler should only be initialized once");
+  TimeTraceProfilerInstance = new TimeTraceProfiler();
+}
+
+void timeTraceProfilerCleanup() {
+  delete TimeTraceProfilerInstance;
+  TimeTraceProfilerInstance = nullptr;
+}
+
+bool timeTraceProfilerEnabled() { return TimeTraceProfilerInstance != nullptr; }
+
+void timeTraceProfilerWrite(llvm::raw_pwrite_stream &OS) {
+  assert(TimeTraceProfilerInstance != nullptr &&
+         "Profiler object cannot be written if it is not initialized");
+  TimeTraceProfilerInstance->write(OS);
+}
+
+void timeTraceProfilerBegin(StringRef Name, StringRef Detail) {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->begin(Name, Detail);
+}
+
+void timeTraceProfilerEnd() {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->end();
+}
+
+} // namespace clang
@@ -32,6 +32,7 @@
 #include "clang/CodeGen/CGFunctionInfo.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "clang/Sema/SemaDiagnostic.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Intrinsics.h"
@@ -41,6 +42,13 @@
 using namespace clang;
 using namespace CodeGen;
 
+#define DEBUG_TYPE "codegenfunction"
+
+STATISTIC(NumConstantFoldQueries,
+          "The # of constant fold queries on branch conditions");
+STATISTIC(NumConstantFoldCacheHits,
+          "The # of constant fold queries served from the per-function cache");
+
 /// shouldEmitLifetimeMarkers - Decide whether we need emit the life-time
 /// markers.
 static bool shouldEmitLifetimeMarkers(const CodeGenOptions &CGOpts,
@@ -1513,14 +1521,34 @@ bool CodeGenFunction::ConstantFoldsToSimpleInteger(const Expr *Cond,
                                                    bool AllowLabels) {
   // FIXME: Rename and handle conversion of other evaluatable things
   // to bool.
-  llvm::APSInt Int;
-  if (!Cond->EvaluateAsInt(Int, getContext()))
+  ++NumConstantFoldQueries;
+
+  // Branch emission folds the same condition repeatedly: EmitBranchOnBoolExpr
+  // probes both sides of every short-circuit operator before recursing, and
+  // EmitIfStmt/VisitBinLAnd each re-fold subexpressions the recursion visits
+  // again.  Expressions are immutable after Sema, so memoize the evaluator's
+  // verdict for the duration of the function.
+  llvm::DenseMap<const Expr *, ConstantFoldInfo>::iterator It =
+      ConstantFoldCache.find(Cond);
+  if (It == ConstantFoldCache.end()) {
+    ConstantFoldInfo Info;
+    Info.Folds = Cond->EvaluateAsInt(Info.Value, getContext());
+    // The label check is kept out of the cached verdict because callers
+    // disagree on AllowLabels; it only runs for foldable conditions.
+    Info.HasLabel = Info.Folds && CodeGenFunction::ContainsLabel(Cond);
+    It = ConstantFoldCache.insert(std::make_pair(Cond, Info)).first;
+  } else {
+    ++NumConstantFoldCacheHits;
+  }
+
+  const ConstantFoldInfo &Info = It->second;
+  if (!Info.Folds)
     return false;  // Not foldable, not integer or not fully evaluatable.
 
-  if (!AllowLabels && CodeGenFunction::ContainsLabel(Cond))
+  if (!AllowLabels && Info.HasLabel)
     return false;  // Contains a label.
 
-  ResultInt = Int;
+  ResultInt = Info.Value;
   return true;
 }
 
@@ -1370,6 +1370,20 @@ private:
   llvm::DenseMap<const OpaqueValueExpr *, LValue> OpaqueLValues;
   llvm::DenseMap<const OpaqueValueExpr *, RValue> OpaqueRValues;
 
+  /// Memoized results of ConstantFoldsToSimpleInteger.  Branch emission
+  /// typically folds the same condition several times (once to decide whether
+  /// the branch is constant, again while emitting each arm of a short-circuit
+  /// operator); expressions are immutable after Sema, so the result of the
+  /// evaluator never changes within a function.  Entries record whether the
+  /// expression folded, its value if so, and whether it contains a label
+  /// (checked separately because callers differ on AllowLabels).
+  struct ConstantFoldInfo {
+    llvm::APSInt Value;
+    bool Folds;
+    bool HasLabel;
+  };
+  llvm::DenseMap<const Expr *, ConstantFoldInfo> ConstantFoldCache;
+
   // VLASizeMap - This keeps track of the associated size for each VLA type.
   // We track this by the size expression rather than the type itself because
   // in certain situations, like a const qualifier applied to an VLA typedef,
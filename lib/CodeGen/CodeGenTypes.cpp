@@ -23,12 +23,21 @@
 #include "clang/AST/Expr.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/CodeGen/CGFunctionInfo.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/DerivedTypes.h"
 #include "llvm/IR/Module.h"
 using namespace clang;
 using namespace CodeGen;
 
+#define DEBUG_TYPE "codegentypes"
+
+STATISTIC(NumTypeConversions, "Number of LLVM type conversion queries");
+STATISTIC(NumTypeCacheHits,
+          "Number of type conversions served from the cache");
+STATISTIC(NumTypeCacheFlushes,
+          "Number of conservative whole-cache type flushes");
+
 CodeGenTypes::CodeGenTypes(CodeGenModule &cgm)
   : CGM(cgm), Context(cgm.getContext()), TheModule(cgm.getModule()),
     Target(cgm.getTarget()), TheCXXABI(cgm.getCXXABI()),
@@ -250,8 +259,10 @@ void CodeGenTypes::UpdateCompletedType(const TagDecl *TD) {
       // Okay, we formed some types based on this.  We speculated that the enum
       // would be lowered to i32, so we only need to flush the cache if this
       // didn't happen.
-      if (!ConvertType(ED->getIntegerType())->isIntegerTy(32))
+      if (!ConvertType(ED->getIntegerType())->isIntegerTy(32)) {
+        ++NumTypeCacheFlushes;
         TypeCache.clear();
+      }
     }
     // If necessary, provide the full definition of a type only used with a
     // declaration so far.
@@ -282,6 +293,7 @@ void CodeGenTypes::RefreshTypeCacheForClass(const CXXRecordDecl *RD) {
 
   const Type *Ty = T.getTypePtr();
   if (RecordsWithOpaqueMemberPointers.count(Ty)) {
+    ++NumTypeCacheFlushes;
     TypeCache.clear();
     RecordsWithOpaqueMemberPointers.clear();
   }
@@ -370,8 +382,10 @@ llvm::Type *CodeGenTypes::ConvertFunctionType(QualType QFT,
 
   RecordsBeingLaidOut.erase(Ty);
 
-  if (SkippedLayout)
+  if (SkippedLayout) {
+    ++NumTypeCacheFlushes;
     TypeCache.clear();
+  }
 
   if (RecordsBeingLaidOut.empty())
     while (!DeferredRecords.empty())
@@ -389,11 +403,15 @@ llvm::Type *CodeGenTypes::ConvertType(QualType T) {
   if (const RecordType *RT = dyn_cast<RecordType>(Ty))
     return ConvertRecordDeclType(RT->getDecl());
 
+  ++NumTypeConversions;
+
   // See if type is already cached.
   llvm::DenseMap<const Type *, llvm::Type *>::iterator TCI = TypeCache.find(Ty);
   // If type is found in map then use it. Otherwise, convert type T.
-  if (TCI != TypeCache.end())
+  if (TCI != TypeCache.end()) {
+    ++NumTypeCacheHits;
     return TCI->second;
+  }
 
   // If we don't have it in the cache, convert it now.
   llvm::Type *ResultType = nullptr;
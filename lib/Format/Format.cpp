@@ -2191,7 +2191,10 @@ reformat(const FormatStyle &Style, StringRef Code,
     if (NewCode) {
       Fixes = Fixes.merge(PassFixes.first);
       Penalty += PassFixes.second;
-      if (I + 1 < E) {
+      // If the pass didn't change anything, the code and the ranges are
+      // unchanged as well; keep the existing Environment instead of copying
+      // the whole file and rebuilding a virtual SourceManager for it.
+      if (I + 1 < E && !PassFixes.first.empty()) {
         CurrentCode = std::move(*NewCode);
         Env = llvm::make_unique<Environment>(
             *CurrentCode, FileName,
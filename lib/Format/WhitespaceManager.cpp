@@ -475,6 +475,17 @@ void WhitespaceManager::alignTrailingComments() {
   unsigned StartOfSequence = 0;
   bool BreakBeforeNext = false;
   unsigned Newlines = 0;
+
+  // For each change, the index of the next change that is not a comment.
+  // Computed in one backward pass so that checking whether a comment on its
+  // own line was aligned with the following code is O(1); scanning forward
+  // per comment is quadratic over long runs of comment-only lines.
+  SmallVector<unsigned, 16> NextNonComment(Changes.size(), Changes.size());
+  for (unsigned i = Changes.size(); i != 0; --i) {
+    unsigned Next = i < Changes.size() ? NextNonComment[i] : Changes.size();
+    NextNonComment[i - 1] = Changes[i - 1].Tok->is(tok::comment) ? Next : i - 1;
+  }
+
   for (unsigned i = 0, e = Changes.size(); i != e; ++i) {
     if (Changes[i].StartOfBlockComment)
       continue;
@@ -506,12 +517,10 @@ void WhitespaceManager::alignTrailingComments() {
                                   Changes[i - 1].StartOfTokenColumn == 0;
     bool WasAlignedWithStartOfNextLine = false;
     if (Changes[i].NewlinesBefore == 1) { // A comment on its own line.
-      unsigned CommentColumn = SourceMgr.getSpellingColumnNumber(
-          Changes[i].OriginalWhitespaceRange.getEnd());
-      for (unsigned j = i + 1; j != e; ++j) {
-        if (Changes[j].Tok->is(tok::comment))
-          continue;
-
+      unsigned j = i + 1 != e ? NextNonComment[i + 1] : e;
+      if (j != e) {
+        unsigned CommentColumn = SourceMgr.getSpellingColumnNumber(
+            Changes[i].OriginalWhitespaceRange.getEnd());
         unsigned NextColumn = SourceMgr.getSpellingColumnNumber(
             Changes[j].OriginalWhitespaceRange.getEnd());
         // The start of the next token was previously aligned with the
@@ -519,7 +528,6 @@ void WhitespaceManager::alignTrailingComments() {
         WasAlignedWithStartOfNextLine =
             CommentColumn == NextColumn ||
             CommentColumn == NextColumn + Style.IndentWidth;
-        break;
       }
     }
     if (!Style.AlignTrailingComments || FollowsRBraceInColumn0) {
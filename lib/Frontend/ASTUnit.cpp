@@ -79,6 +79,7 @@
 #include "llvm/Bitcode/BitstreamWriter.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/Chrono.h"
 #include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/DJB.h"
 #include "llvm/Support/ErrorHandling.h"
@@ -615,11 +616,19 @@ class StoredDiagnosticConsumer : public DiagnosticConsumer {
   const LangOptions *LangOpts = nullptr;
   SourceManager *SourceMgr = nullptr;
 
+  /// If non-null and non-zero, cap the number of diagnostics stored per
+  /// (diagnostic ID, file) pair; overflow is tallied in *OverflowCounter.
+  const unsigned *Cap = nullptr;
+  unsigned *OverflowCounter = nullptr;
+  llvm::DenseMap<std::pair<unsigned, FileID>, unsigned> NumStoredPerIDAndFile;
+
 public:
   StoredDiagnosticConsumer(
       SmallVectorImpl<StoredDiagnostic> *StoredDiags,
-      SmallVectorImpl<ASTUnit::StandaloneDiagnostic> *StandaloneDiags)
-      : StoredDiags(StoredDiags), StandaloneDiags(StandaloneDiags) {
+      SmallVectorImpl<ASTUnit::StandaloneDiagnostic> *StandaloneDiags,
+      const unsigned *Cap = nullptr, unsigned *OverflowCounter = nullptr)
+      : StoredDiags(StoredDiags), StandaloneDiags(StandaloneDiags), Cap(Cap),
+        OverflowCounter(OverflowCounter) {
     assert((StoredDiags || StandaloneDiags) &&
            "No output collections were passed to StoredDiagnosticConsumer.");
   }
@@ -629,6 +638,10 @@ public:
     this->LangOpts = &LangOpts;
     if (PP)
       SourceMgr = &PP->getSourceManager();
+    // Each parse starts over, so the per-file occurrence counts do too.
+    NumStoredPerIDAndFile.clear();
+    if (OverflowCounter)
+      *OverflowCounter = 0;
   }
 
   void HandleDiagnostic(DiagnosticsEngine::Level Level,
@@ -677,6 +690,20 @@ void StoredDiagnosticConsumer::HandleDiagnostic(DiagnosticsEngine::Level Level,
   // about. This effectively drops diagnostics from modules we're building.
   // FIXME: In the long run, ee don't want to drop source managers from modules.
   if (!Info.hasSourceManager() || &Info.getSourceManager() == SourceMgr) {
+    // Enforce the per-(ID, file) cap, if one was configured.  Errors are
+    // still counted above; only the stored copy is elided.
+    if (Cap && *Cap && Info.hasSourceManager() &&
+        Info.getLocation().isValid()) {
+      unsigned &NumStored = NumStoredPerIDAndFile[std::make_pair(
+          Info.getID(), Info.getSourceManager().getFileID(Info.getLocation()))];
+      if (NumStored >= *Cap) {
+        if (OverflowCounter)
+          ++*OverflowCounter;
+        return;
+      }
+      ++NumStored;
+    }
+
     StoredDiagnostic *ResultDiag = nullptr;
     if (StoredDiags) {
       StoredDiags->emplace_back(Level, Info);
@@ -727,7 +754,9 @@ void ASTUnit::ConfigureDiags(IntrusiveRefCntPtr<DiagnosticsEngine> Diags,
                              ASTUnit &AST, bool CaptureDiagnostics) {
   assert(Diags.get() && "no DiagnosticsEngine was provided");
   if (CaptureDiagnostics)
-    Diags->setClient(new StoredDiagnosticConsumer(&AST.StoredDiagnostics, nullptr));
+    Diags->setClient(new StoredDiagnosticConsumer(
+        &AST.StoredDiagnostics, nullptr, &AST.StoredDiagnosticCap,
+        &AST.NumStoredDiagnosticsOverflowed));
 }
 
 std::unique_ptr<ASTUnit> ASTUnit::LoadFromASTFile(
@@ -877,7 +906,14 @@ static void AddTopLevelDeclarationToHash(Decl *D, unsigned &Hash) {
   if (!DC)
     return;
 
-  if (!(DC->isTranslationUnit() || DC->getLookupParent()->isTranslationUnit()))
+  // Consider any decl that is visible from the translation unit through a
+  // chain of namespaces; the cached global code-completion results include
+  // namespace members at every depth, so their changes must invalidate the
+  // cache too.
+  DeclContext *LookupDC = DC;
+  while (LookupDC && LookupDC->isNamespace())
+    LookupDC = LookupDC->getLookupParent();
+  if (!LookupDC || !LookupDC->isTranslationUnit())
     return;
 
   if (const auto *ND = dyn_cast<NamedDecl>(D)) {
@@ -942,8 +978,12 @@ public:
   void handleFileLevelDecl(Decl *D) {
     Unit.addFileLevelDecl(D);
     if (auto *NSD = dyn_cast<NamespaceDecl>(D)) {
-      for (auto *I : NSD->decls())
+      for (auto *I : NSD->decls()) {
+        // Namespace members contribute to the completion-cache hash as well;
+        // handleTopLevelDecl only hashed the namespace itself.
+        AddTopLevelDeclarationToHash(I, Hash);
         handleFileLevelDecl(I);
+      }
     }
   }
 
@@ -1793,6 +1833,61 @@ ASTUnit *ASTUnit::LoadFromCommandLine(
   return AST.release();
 }
 
+bool ASTUnit::inputsUnchangedSinceParse(
+    ArrayRef<std::pair<std::string, llvm::MemoryBuffer *>> RemappedFiles,
+    llvm::vfs::FileSystem &VFS) {
+  // Only usable when the previous parse completed far enough to leave a
+  // live AST and its FileManager behind.
+  if (!Ctx || !PP || !SourceMgr || !FileMgr)
+    return false;
+
+  // If we are still counting down toward building a precompiled preamble,
+  // take the normal path so the preamble eventually gets built.
+  if (!Preamble && PreambleRebuildCounter > 0)
+    return false;
+
+  // The remapped-buffer set must be unchanged: the same files mapped to
+  // byte-identical contents.
+  PreprocessorOptions &PPOpts = Invocation->getPreprocessorOpts();
+  if (!PPOpts.RemappedFiles.empty())
+    return false;
+  if (RemappedFiles.size() != PPOpts.RemappedFileBuffers.size())
+    return false;
+  llvm::StringSet<> RemappedNames;
+  for (const auto &RF : RemappedFiles) {
+    const llvm::MemoryBuffer *OldBuffer = nullptr;
+    for (const auto &RB : PPOpts.RemappedFileBuffers)
+      if (RF.first == RB.first) {
+        OldBuffer = RB.second;
+        break;
+      }
+    if (!OldBuffer || OldBuffer->getBuffer() != RF.second->getBuffer())
+      return false;
+    RemappedNames.insert(RF.first);
+  }
+
+  // Every path the previous parse asked the FileManager about must resolve
+  // the same way now: files that existed must be unmodified (by the same
+  // size + mtime criterion PCH validation uses), and lookups that failed
+  // must still fail, so a header appearing on disk triggers a real reparse.
+  bool Unchanged = true;
+  FileMgr->forEachSeenFileEntry([&](StringRef Path, const FileEntry *FE) {
+    if (!Unchanged || RemappedNames.count(Path))
+      return;
+    llvm::ErrorOr<llvm::vfs::Status> Status = VFS.status(Path);
+    if (!FE) {
+      if (Status)
+        Unchanged = false;
+      return;
+    }
+    if (!Status || Status->getSize() != uint64_t(FE->getSize()) ||
+        llvm::sys::toTimeT(Status->getLastModificationTime()) !=
+            FE->getModificationTime())
+      Unchanged = false;
+  });
+  return Unchanged;
+}
+
 bool ASTUnit::Reparse(std::shared_ptr<PCHContainerOperations> PCHContainerOps,
                       ArrayRef<RemappedFile> RemappedFiles,
                       IntrusiveRefCntPtr<llvm::vfs::FileSystem> VFS) {
@@ -1804,11 +1899,13 @@ bool ASTUnit::Reparse(std::shared_ptr<PCHContainerOperations> PCHContainerOps,
     VFS = FileMgr->getVirtualFileSystem();
   }
 
-  clearFileLevelDecls();
-
   SimpleTimer ParsingTimer(WantTiming);
   ParsingTimer.setOutput("Reparsing " + getMainFileName());
 
+  // Check whether we can skip the reparse entirely before the remapping
+  // below destroys the buffers we compare against.
+  bool InputsUnchanged = inputsUnchangedSinceParse(RemappedFiles, *VFS);
+
   // Remap files.
   PreprocessorOptions &PPOpts = Invocation->getPreprocessorOpts();
   for (const auto &RB : PPOpts.RemappedFileBuffers)
@@ -1820,6 +1917,13 @@ bool ASTUnit::Reparse(std::shared_ptr<PCHContainerOperations> PCHContainerOps,
                                                       RemappedFile.second);
   }
 
+  // If nothing the previous parse read has changed, the current AST (and
+  // its stored diagnostics) are still valid; keep them.
+  if (InputsUnchanged)
+    return false;
+
+  clearFileLevelDecls();
+
   // If we have a preamble file lying around, or if we might try to
   // build a precompiled preamble, do so now.
   std::unique_ptr<llvm::MemoryBuffer> OverrideMainBuffer;
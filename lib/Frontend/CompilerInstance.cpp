@@ -14,6 +14,7 @@
 #include "clang/Basic/CharInfo.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/MemoryBufferCache.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Stack.h"
@@ -41,7 +42,9 @@
 #include "llvm/Support/CrashRecoveryContext.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Host.h"
+#include "llvm/Support/JSON.h"
 #include "llvm/Support/LockFileManager.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -308,6 +311,8 @@ FileManager *CompilerInstance::createFileManager() {
     setVirtualFileSystem(VFS);
   }
   FileMgr = new FileManager(getFileSystemOpts(), VirtualFileSystem);
+  if (getFileSystemOpts().CacheDirEntries)
+    FileMgr->addStatCache(llvm::make_unique<DirectoryScanStatCache>());
   return FileMgr.get();
 }
 
@@ -388,6 +393,11 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
   getTarget().adjust(getLangOpts());
   PP->Initialize(getTarget(), getAuxTarget());
 
+  if (getFrontendOpts().ShowStats) {
+    PP->enableMacroExpansionStats();
+    PP->enablePragmaUsageStats();
+  }
+
   // Note that this is different then passing PTHMgr to Preprocessor's ctor.
   // That argument is used as the IdentifierInfoLookup argument to
   // IdentifierTable's ctor.
@@ -618,6 +628,34 @@ void CompilerInstance::createFrontendTimer() {
                       *FrontendTimerGroup));
 }
 
+void CompilerInstance::writeMemoryUsageReport(raw_ostream &OS) {
+  llvm::json::Object Report;
+
+  if (hasSourceManager()) {
+    const SourceManager &SM = getSourceManager();
+    SourceManager::MemoryBufferSizes BufSizes = SM.getMemoryBufferSizes();
+    Report["source-manager"] = llvm::json::Object{
+        {"malloced-buffers-bytes", int64_t(BufSizes.malloc_bytes)},
+        {"mmapped-buffers-bytes", int64_t(BufSizes.mmap_bytes)},
+        {"data-structures-bytes", int64_t(SM.getDataStructureSizes())}};
+  }
+
+  if (hasPreprocessor())
+    Report["preprocessor-bytes"] = int64_t(getPreprocessor().getTotalMemory());
+
+  if (hasASTContext()) {
+    const ASTContext &Context = getASTContext();
+    Report["ast-context"] = llvm::json::Object{
+        {"arena-bytes", int64_t(Context.getASTAllocatedMemory())},
+        {"side-tables-bytes", int64_t(Context.getSideTableAllocatedMemory())}};
+  }
+
+  if (hasSema())
+    Report["sema-arena-bytes"] = int64_t(getSema().BumpAlloc.getTotalMemory());
+
+  OS << llvm::formatv("{0:2}", llvm::json::Value(std::move(Report))) << "\n";
+}
+
 CodeCompleteConsumer *
 CompilerInstance::createCodeCompletionConsumer(Preprocessor &PP,
                                                StringRef Filename,
@@ -932,6 +932,11 @@ bool FrontendAction::Execute() {
 void FrontendAction::EndSourceFile() {
   CompilerInstance &CI = getCompilerInstance();
 
+  // Report memory usage while the per-file objects are still alive; they are
+  // freed (or deliberately leaked) below.
+  if (CI.getFrontendOpts().ShowMemoryUsage)
+    CI.writeMemoryUsageReport(llvm::errs());
+
   // Inform the diagnostic client we are done with this source file.
   CI.getDiagnosticClient().EndSourceFile();
 
@@ -962,6 +967,8 @@ void FrontendAction::EndSourceFile() {
     CI.getPreprocessor().getIdentifierTable().PrintStats();
     CI.getPreprocessor().getHeaderSearchInfo().PrintStats();
     CI.getSourceManager().PrintStats();
+    llvm::errs() << CI.getDiagnostics().getNumSuppressed()
+                 << " diagnostics suppressed before rendering.\n";
     llvm::errs() << "\n";
   }
 
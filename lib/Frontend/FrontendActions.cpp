@@ -9,6 +9,7 @@
 
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/AST/ASTConsumer.h"
+#include "clang/AST/ODRHash.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Frontend/ASTConsumers.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -22,6 +23,8 @@
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/ASTWriter.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
@@ -91,6 +94,74 @@ ASTViewAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
   return CreateASTViewer();
 }
 
+namespace {
+
+/// Prints one manifest line per hashable top-level declaration: a stable
+/// semantic hash followed by the qualified name.  The hash is computed with
+/// ODRHash, so it covers what the declaration means (including inline
+/// bodies, which are part of a header's interface) but not comments,
+/// whitespace, or source coordinates; a build system can diff two manifests
+/// to decide whether an edit changed anything dependents can observe.
+class DeclHashesConsumer : public ASTConsumer {
+  std::unique_ptr<raw_ostream> OS;
+
+public:
+  DeclHashesConsumer(std::unique_ptr<raw_ostream> OS) : OS(std::move(OS)) {}
+
+  void HandleTranslationUnit(ASTContext &Context) override {
+    PrintDeclHashes(Context.getTranslationUnitDecl());
+  }
+
+private:
+  void PrintDeclHashes(const DeclContext *DC) {
+    for (const Decl *D : DC->decls()) {
+      // Walk into namespaces and linkage specs so namespaced interfaces
+      // appear in the manifest; their members are emitted individually.
+      if (const auto *Inner = dyn_cast<NamespaceDecl>(D)) {
+        PrintDeclHashes(Inner);
+        continue;
+      }
+      if (const auto *Inner = dyn_cast<LinkageSpecDecl>(D)) {
+        PrintDeclHashes(Inner);
+        continue;
+      }
+
+      // Hash the declaration kinds ODRHash models completely.  Other
+      // top-level decls (typedefs, variables) change dependents through
+      // these or through the token stream, which -token-hash covers.
+      ODRHash Hash;
+      if (const auto *RD = dyn_cast<CXXRecordDecl>(D)) {
+        if (!RD->hasDefinition() || RD->getDefinition() != RD)
+          continue;
+        Hash.AddCXXRecordDecl(RD);
+      } else if (const auto *FD = dyn_cast<FunctionDecl>(D)) {
+        Hash.AddFunctionDecl(FD);
+      } else if (const auto *ED = dyn_cast<EnumDecl>(D)) {
+        if (!ED->isCompleteDefinition())
+          continue;
+        Hash.AddEnumDecl(ED);
+      } else {
+        continue;
+      }
+
+      *OS << llvm::format("%08x", Hash.CalculateHash()) << ' ';
+      cast<NamedDecl>(D)->printQualifiedName(*OS);
+      *OS << '\n';
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<ASTConsumer>
+EmitDeclHashesAction::CreateASTConsumer(CompilerInstance &CI,
+                                        StringRef InFile) {
+  if (std::unique_ptr<raw_ostream> OS =
+          CI.createDefaultOutputFile(false, InFile))
+    return llvm::make_unique<DeclHashesConsumer>(std::move(OS));
+  return nullptr;
+}
+
 std::unique_ptr<ASTConsumer>
 GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
   std::string Sysroot;
@@ -750,6 +821,42 @@ void DumpTokensAction::ExecuteAction() {
   } while (Tok.isNot(tok::eof));
 }
 
+void PrintTokenHashAction::ExecuteAction() {
+  Preprocessor &PP = getCompilerInstance().getPreprocessor();
+
+  // Hash only (kind, spelling) pairs: source coordinates, whitespace and
+  // comments do not contribute, so the digest survives reformatting and
+  // line-marker churn that invalidates raw preprocessed output as a cache
+  // key.  Both fields are delimited to keep the encoding unambiguous.  MD5
+  // is used because it hashes incrementally; the token stream is never
+  // materialized.
+  llvm::MD5 Hash;
+  SmallString<64> SpellingBuffer;
+  Token Tok;
+  PP.EnterMainSourceFile();
+  do {
+    PP.Lex(Tok);
+    unsigned Kind = Tok.getKind();
+    uint8_t KindBytes[2] = {uint8_t(Kind & 0xFF), uint8_t(Kind >> 8)};
+    Hash.update(KindBytes);
+    // Annotation tokens (pragmas surviving preprocessing) have no spelling
+    // and are covered by their kind alone.
+    if (!Tok.isAnnotation()) {
+      SpellingBuffer.clear();
+      StringRef Spelling = PP.getSpelling(Tok, SpellingBuffer);
+      unsigned Len = Spelling.size();
+      uint8_t LenBytes[4] = {uint8_t(Len & 0xFF), uint8_t((Len >> 8) & 0xFF),
+                             uint8_t((Len >> 16) & 0xFF), uint8_t(Len >> 24)};
+      Hash.update(LenBytes);
+      Hash.update(Spelling);
+    }
+  } while (Tok.isNot(tok::eof));
+
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  llvm::outs() << Result.digest() << '\n';
+}
+
 void GeneratePTHAction::ExecuteAction() {
   CompilerInstance &CI = getCompilerInstance();
   std::unique_ptr<raw_pwrite_stream> OS =
@@ -766,6 +873,15 @@ void PreprocessOnlyAction::ExecuteAction() {
   // Ignore unknown pragmas.
   PP.IgnorePragmas();
 
+  // When this action is only driving dependency-file generation (-M and
+  // friends), every token outside of a directive is discarded unseen, so
+  // skip macro expansion for them; which files get included can only be
+  // affected by expansion inside directives, and that still happens.  Plain
+  // -Eonly keeps full expansion since it is used to exercise expansion-time
+  // diagnostics.
+  if (!getCompilerInstance().getDependencyOutputOpts().OutputFile.empty())
+    PP.SetMacroExpansionOnlyInDirectives();
+
   Token Tok;
   // Start parsing the specified input file.
   PP.EnterMainSourceFile();
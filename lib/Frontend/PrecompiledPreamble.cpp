@@ -25,11 +25,13 @@
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/CrashRecoveryContext.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Mutex.h"
 #include "llvm/Support/MutexGuard.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include <cstring>
 #include <limits>
 #include <utility>
 
@@ -408,6 +410,153 @@ std::size_t PrecompiledPreamble::getSize() const {
   llvm_unreachable("Unhandled storage kind");
 }
 
+namespace {
+
+/// Magic number and format version for preamble files written by
+/// PrecompiledPreamble::StoreToFile().
+const char PreambleFileMagic[] = "CPRE";
+const uint32_t PreambleFileVersion = 1;
+
+/// Bounds-checked little-endian reader over a serialized preamble buffer.
+class PreambleBlobReader {
+public:
+  PreambleBlobReader(StringRef Buffer)
+      : Ptr(Buffer.begin()), End(Buffer.end()) {}
+
+  bool readBytes(uint64_t Size, StringRef &Out) {
+    if (uint64_t(End - Ptr) < Size)
+      return false;
+    Out = StringRef(Ptr, Size);
+    Ptr += Size;
+    return true;
+  }
+
+  template <typename T> bool readInt(T &Out) {
+    StringRef Bytes;
+    if (!readBytes(sizeof(T), Bytes))
+      return false;
+    Out = llvm::support::endian::read<T, llvm::support::little,
+                                      llvm::support::unaligned>(Bytes.data());
+    return true;
+  }
+
+private:
+  const char *Ptr;
+  const char *End;
+};
+
+} // namespace
+
+std::error_code PrecompiledPreamble::StoreToFile(StringRef Path) const {
+  // Get at the PCH payload before opening the output so a failure cannot
+  // leave a truncated file behind.
+  StringRef Payload;
+  std::unique_ptr<llvm::MemoryBuffer> PayloadBuffer;
+  switch (Storage.getKind()) {
+  case PCHStorage::Kind::Empty:
+    assert(false && "Calling StoreToFile() on invalid PrecompiledPreamble. "
+                    "Was it std::moved?");
+    return std::make_error_code(std::errc::invalid_argument);
+  case PCHStorage::Kind::InMemory:
+    Payload = Storage.asMemory().Data;
+    break;
+  case PCHStorage::Kind::TempFile: {
+    auto BufferOrErr =
+        llvm::MemoryBuffer::getFile(Storage.asFile().getFilePath());
+    if (!BufferOrErr)
+      return BufferOrErr.getError();
+    PayloadBuffer = std::move(*BufferOrErr);
+    Payload = PayloadBuffer->getBuffer();
+    break;
+  }
+  }
+
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(Path, EC, llvm::sys::fs::F_None);
+  if (EC)
+    return EC;
+  llvm::support::endian::Writer W(OS, llvm::support::little);
+
+  OS.write(PreambleFileMagic, 4);
+  W.write<uint32_t>(PreambleFileVersion);
+  W.write<uint8_t>(PreambleEndsAtStartOfLine);
+
+  W.write<uint64_t>(PreambleBytes.size());
+  OS.write(PreambleBytes.data(), PreambleBytes.size());
+
+  W.write<uint32_t>(FilesInPreamble.size());
+  for (const auto &F : FilesInPreamble) {
+    W.write<uint32_t>(F.first().size());
+    OS.write(F.first().data(), F.first().size());
+    W.write<uint64_t>(uint64_t(F.second.Size));
+    W.write<uint64_t>(uint64_t(F.second.ModTime));
+    OS.write(reinterpret_cast<const char *>(F.second.MD5.Bytes.data()),
+             F.second.MD5.Bytes.size());
+  }
+
+  W.write<uint64_t>(Payload.size());
+  OS.write(Payload.data(), Payload.size());
+
+  OS.close();
+  return OS.has_error() ? OS.error() : std::error_code();
+}
+
+llvm::ErrorOr<PrecompiledPreamble>
+PrecompiledPreamble::LoadFromFile(StringRef Path) {
+  auto BufferOrErr = llvm::MemoryBuffer::getFile(Path);
+  if (!BufferOrErr)
+    return BufferOrErr.getError();
+  PreambleBlobReader Reader((*BufferOrErr)->getBuffer());
+
+  auto Malformed = [] {
+    return std::make_error_code(std::errc::illegal_byte_sequence);
+  };
+
+  StringRef Magic;
+  uint32_t Version;
+  if (!Reader.readBytes(4, Magic) || Magic != StringRef(PreambleFileMagic, 4) ||
+      !Reader.readInt(Version) || Version != PreambleFileVersion)
+    return Malformed();
+
+  uint8_t EndsAtStartOfLine;
+  uint64_t PreambleSize;
+  StringRef Bytes;
+  if (!Reader.readInt(EndsAtStartOfLine) || !Reader.readInt(PreambleSize) ||
+      !Reader.readBytes(PreambleSize, Bytes))
+    return Malformed();
+  std::vector<char> PreambleBytes(Bytes.begin(), Bytes.end());
+
+  uint32_t NumFiles;
+  if (!Reader.readInt(NumFiles))
+    return Malformed();
+  llvm::StringMap<PreambleFileHash> FilesInPreamble;
+  for (uint32_t I = 0; I != NumFiles; ++I) {
+    uint32_t PathLen;
+    StringRef FilePath, MD5Bytes;
+    uint64_t Size, ModTime;
+    if (!Reader.readInt(PathLen) || !Reader.readBytes(PathLen, FilePath) ||
+        !Reader.readInt(Size) || !Reader.readInt(ModTime) ||
+        !Reader.readBytes(sizeof(llvm::MD5::MD5Result), MD5Bytes))
+      return Malformed();
+    PreambleFileHash Hash;
+    Hash.Size = off_t(Size);
+    Hash.ModTime = time_t(ModTime);
+    memcpy(Hash.MD5.Bytes.data(), MD5Bytes.data(), MD5Bytes.size());
+    FilesInPreamble.insert({FilePath, Hash});
+  }
+
+  uint64_t PayloadSize;
+  StringRef Payload;
+  if (!Reader.readInt(PayloadSize) || !Reader.readBytes(PayloadSize, Payload))
+    return Malformed();
+
+  InMemoryPreamble Memory;
+  Memory.Data = Payload.str();
+  return PrecompiledPreamble(PCHStorage(std::move(Memory)),
+                             std::move(PreambleBytes), EndsAtStartOfLine,
+                             std::move(FilesInPreamble));
+}
+
 bool PrecompiledPreamble::CanReuse(const CompilerInvocation &Invocation,
                                    const llvm::MemoryBuffer *MainFileBuffer,
                                    PreambleBounds Bounds,
@@ -602,8 +602,7 @@ bool PrintPPOutputPPCallbacks::HandleFirstTokOnLine(Token &Tok) {
     OS << ' ';
 
   // Otherwise, indent the appropriate number of spaces.
-  for (; ColNo > 1; --ColNo)
-    OS << ' ';
+  OS.indent(ColNo > 1 ? ColNo - 1 : 0);
 
   return true;
 }
@@ -877,17 +876,17 @@ void clang::DoPrintPreprocessedInput(Preprocessor &PP, raw_ostream *OS,
   // should not be emitted into the output and are guaranteed to be at the
   // start.
   const SourceManager &SourceMgr = PP.getSourceManager();
+  FileID PredefinesFID = PP.getPredefinesFileID();
   Token Tok;
   do {
     PP.Lex(Tok);
     if (Tok.is(tok::eof) || !Tok.getLocation().isFileID())
       break;
 
-    PresumedLoc PLoc = SourceMgr.getPresumedLoc(Tok.getLocation());
-    if (PLoc.isInvalid())
-      break;
-
-    if (strcmp(PLoc.getFilename(), "<built-in>"))
+    // Checking the FileID against the predefines buffer is equivalent to the
+    // old "is the presumed filename <built-in>" test, but skips the presumed
+    // location computation for each of the several thousand predefine tokens.
+    if (SourceMgr.getFileID(Tok.getLocation()) != PredefinesFID)
       break;
   } while (true);
 
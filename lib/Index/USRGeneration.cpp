@@ -12,6 +12,7 @@
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/DeclVisitor.h"
 #include "clang/Lex/PreprocessingRecord.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -56,22 +57,39 @@ static StringRef GetExternalSourceContainer(const NamedDecl *D) {
 }
 
 namespace {
+
+/// The USR fragment a DeclContext contributes, cached for reuse across the
+/// decls of a batch.  Because USRs compress repeated types by referencing
+/// earlier mentions, the type-substitution state left behind by the prefix
+/// must be replayed along with its text.
+struct CachedUSRPrefix {
+  std::string Text;
+  llvm::DenseMap<const Type *, unsigned> TypeSubs;
+  bool Ignore;
+  bool GeneratedLoc;
+};
+
+using USRPrefixCache = llvm::DenseMap<const DeclContext *, CachedUSRPrefix>;
+
 class USRGenerator : public ConstDeclVisitor<USRGenerator> {
   SmallVectorImpl<char> &Buf;
   llvm::raw_svector_ostream Out;
   bool IgnoreResults;
   ASTContext *Context;
   bool generatedLoc;
+  USRPrefixCache *PrefixCache;
 
   llvm::DenseMap<const Type *, unsigned> TypeSubstitutions;
 
 public:
-  explicit USRGenerator(ASTContext *Ctx, SmallVectorImpl<char> &Buf)
+  explicit USRGenerator(ASTContext *Ctx, SmallVectorImpl<char> &Buf,
+                        USRPrefixCache *PrefixCache = nullptr)
   : Buf(Buf),
     Out(Buf),
     IgnoreResults(false),
     Context(Ctx),
-    generatedLoc(false)
+    generatedLoc(false),
+    PrefixCache(PrefixCache)
   {
     // Add the USR space prefix.
     Out << getUSRSpacePrefix();
@@ -191,9 +209,32 @@ bool USRGenerator::ShouldGenerateLocation(const NamedDecl *D) {
 }
 
 void USRGenerator::VisitDeclContext(const DeclContext *DC) {
-  if (const NamedDecl *D = dyn_cast<NamedDecl>(DC))
+  if (const NamedDecl *D = dyn_cast<NamedDecl>(DC)) {
+    // A context's fragment can only be cached (or replayed) when it lands
+    // directly after the USR space prefix with no type substitutions
+    // recorded yet; only then are its text and substitution indices
+    // position-independent.
+    if (PrefixCache && Buf.size() == getUSRSpacePrefix().size() &&
+        TypeSubstitutions.empty()) {
+      auto Known = PrefixCache->find(DC);
+      if (Known != PrefixCache->end()) {
+        Out << Known->second.Text;
+        TypeSubstitutions = Known->second.TypeSubs;
+        IgnoreResults |= Known->second.Ignore;
+        generatedLoc |= Known->second.GeneratedLoc;
+        return;
+      }
+      size_t Start = Buf.size();
+      Visit(D);
+      CachedUSRPrefix &Entry = (*PrefixCache)[DC];
+      Entry.Text.assign(Buf.begin() + Start, Buf.end());
+      Entry.TypeSubs = TypeSubstitutions;
+      Entry.Ignore = IgnoreResults;
+      Entry.GeneratedLoc = generatedLoc;
+      return;
+    }
     Visit(D);
-  else if (isa<LinkageSpecDecl>(DC)) // Linkage specs are transparent in USRs.
+  } else if (isa<LinkageSpecDecl>(DC)) // Linkage specs are transparent in USRs.
     VisitDeclContext(DC->getParent());
 }
 
@@ -1071,6 +1112,26 @@ bool clang::index::generateUSRForDecl(const Decl *D,
   return UG.ignoreResults();
 }
 
+void clang::index::generateUSRsForDecls(
+    ArrayRef<const Decl *> Decls, SmallVectorImpl<char> &Buf,
+    SmallVectorImpl<std::pair<unsigned, unsigned>> &USRRanges) {
+  USRPrefixCache PrefixCache;
+  SmallString<128> DeclUSR;
+  for (const Decl *D : Decls) {
+    unsigned Start = Buf.size();
+    if (D) {
+      // Generate into a scratch buffer so that an ignored decl's partial
+      // output does not end up in the arena.
+      DeclUSR.clear();
+      USRGenerator UG(&D->getASTContext(), DeclUSR, &PrefixCache);
+      UG.Visit(D);
+      if (!UG.ignoreResults())
+        Buf.append(DeclUSR.begin(), DeclUSR.end());
+    }
+    USRRanges.push_back({Start, unsigned(Buf.size()) - Start});
+  }
+}
+
 bool clang::index::generateUSRForMacro(const MacroDefinitionRecord *MD,
                                        const SourceManager &SM,
                                        SmallVectorImpl<char> &Buf) {
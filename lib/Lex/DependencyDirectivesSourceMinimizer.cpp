@@ -0,0 +1,345 @@
+//===- DependencyDirectivesSourceMinimizer.cpp ----------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a scanner that reduces a source buffer to the
+// preprocessor directives it contains.  It never builds tokens: it walks
+// the raw bytes, classifying each logical line as directive or
+// non-directive, and only models the lexical constructs that can move a
+// line's end or hide a '#' (comments, literals, raw strings, and escaped
+// newlines).
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/DependencyDirectivesSourceMinimizer.h"
+#include "clang/Basic/CharInfo.h"
+#include "llvm/ADT/SmallString.h"
+#include <cstring>
+
+using namespace clang;
+using llvm::SmallVectorImpl;
+using llvm::StringRef;
+
+namespace {
+
+class Minimizer {
+  SmallVectorImpl<char> &Out;
+  const char *const Start;
+  const char *First;
+  const char *const End;
+
+public:
+  Minimizer(SmallVectorImpl<char> &Out, StringRef Input)
+      : Out(Out), Start(Input.begin()), First(Input.begin()),
+        End(Input.end()) {}
+
+  /// Runs the scan. Returns true on error.
+  bool minimize();
+
+private:
+  /// If First points at a backslash-newline splice, returns its length in
+  /// bytes (2, or 3 for a two-character newline); otherwise returns 0.
+  unsigned isEscapedNewline() const {
+    if (*First != '\\' || First + 1 == End || !isVerticalWhitespace(First[1]))
+      return 0;
+    if (First + 2 != End && isVerticalWhitespace(First[2]) &&
+        First[2] != First[1])
+      return 3;
+    return 2;
+  }
+
+  /// Consumes one newline, treating \r\n and \n\r as a single newline.
+  void skipNewline() {
+    assert(isVerticalWhitespace(*First));
+    char C = *First++;
+    if (First != End && isVerticalWhitespace(*First) && *First != C)
+      ++First;
+  }
+
+  /// Returns true if the '"' at First closes a raw string literal prefix
+  /// (R, uR, UR, LR, or u8R forming its own token).
+  bool isAtRawStringQuote() const {
+    assert(*First == '"');
+    const char *P = First;
+    if (P == Start || P[-1] != 'R')
+      return false;
+    --P;
+    if (P == Start)
+      return true;
+    char C = P[-1];
+    if (C == '8' && P - Start >= 2 && P[-2] == 'u' &&
+        (P - Start == 2 || !isIdentifierBody(P[-3])))
+      return true;
+    if ((C == 'u' || C == 'U' || C == 'L') &&
+        (P - Start == 1 || !isIdentifierBody(P[-2])))
+      return true;
+    return !isIdentifierBody(C);
+  }
+
+  /// Skips past a "//" comment, leaving First at the terminating newline
+  /// (or End).  Escaped newlines continue the comment.
+  void skipLineComment() {
+    assert(First[0] == '/' && First[1] == '/');
+    First += 2;
+    while (First != End) {
+      if (isVerticalWhitespace(*First))
+        return;
+      if (unsigned Len = isEscapedNewline())
+        First += Len;
+      else
+        ++First;
+    }
+  }
+
+  /// Skips past a "/*" comment. Returns true if it is unterminated.
+  bool skipBlockComment() {
+    assert(First[0] == '/' && First[1] == '*');
+    First += 2;
+    while (true) {
+      const char *Star =
+          static_cast<const char *>(memchr(First, '*', End - First));
+      if (!Star) {
+        First = End;
+        return true;
+      }
+      First = Star + 1;
+      if (First != End && *First == '/') {
+        ++First;
+        return false;
+      }
+    }
+  }
+
+  /// Skips a character or string literal delimited by \p Terminator.  A
+  /// bare newline ends the scan (the literal is ill-formed, but the real
+  /// lexer recovers at end of line and so do we).
+  void skipLiteral(char Terminator) {
+    assert(*First == Terminator);
+    ++First;
+    while (First != End) {
+      if (*First == Terminator) {
+        ++First;
+        return;
+      }
+      if (isVerticalWhitespace(*First))
+        return;
+      if (*First == '\\') {
+        ++First;
+        if (First == End)
+          return;
+        if (isVerticalWhitespace(*First))
+          skipNewline();
+        else
+          ++First;
+      } else {
+        ++First;
+      }
+    }
+  }
+
+  /// Skips a raw string literal, with First at its opening '"'.  Returns
+  /// true if it is unterminated.
+  bool skipRawString() {
+    assert(*First == '"');
+    ++First;
+    const char *DelimBegin = First;
+    while (First != End && *First != '(' && *First != '"' &&
+           !isVerticalWhitespace(*First) && First - DelimBegin < 16)
+      ++First;
+    if (First == End || *First != '(')
+      return true;
+    SmallString<20> Terminator;
+    Terminator.push_back(')');
+    Terminator.append(DelimBegin, First);
+    Terminator.push_back('"');
+    ++First;
+    size_t Off = StringRef(First, End - First).find(Terminator);
+    if (Off == StringRef::npos) {
+      First = End;
+      return true;
+    }
+    First += Off + Terminator.size();
+    return false;
+  }
+
+  /// Advances over whitespace, escaped newlines, and comments, stopping at
+  /// the first other character.  Because newlines are plain whitespace
+  /// here, the stop position is always the first token of a logical line.
+  /// Returns true on error.
+  bool skipToNextToken() {
+    while (First != End) {
+      char C = *First;
+      if (isHorizontalWhitespace(C) || isVerticalWhitespace(C)) {
+        ++First;
+        continue;
+      }
+      if (unsigned Len = isEscapedNewline()) {
+        First += Len;
+        continue;
+      }
+      if (C == '/' && First + 1 != End) {
+        if (First[1] == '/') {
+          skipLineComment();
+          continue;
+        }
+        if (First[1] == '*') {
+          if (skipBlockComment())
+            return true;
+          continue;
+        }
+      }
+      break;
+    }
+    return false;
+  }
+
+  /// Consumes the rest of a non-directive logical line, including any
+  /// continuation lines. Returns true on error.
+  bool skipLine() {
+    while (First != End) {
+      char C = *First;
+      if (isVerticalWhitespace(C)) {
+        skipNewline();
+        return false;
+      }
+      if (unsigned Len = isEscapedNewline()) {
+        First += Len;
+        continue;
+      }
+      if (C == '\'') {
+        skipLiteral('\'');
+        continue;
+      }
+      if (C == '"') {
+        if (isAtRawStringQuote()) {
+          if (skipRawString())
+            return true;
+        } else {
+          skipLiteral('"');
+        }
+        continue;
+      }
+      if (C == '/' && First + 1 != End) {
+        if (First[1] == '/') {
+          skipLineComment();
+          continue;
+        }
+        if (First[1] == '*') {
+          if (skipBlockComment())
+            return true;
+          continue;
+        }
+      }
+      ++First;
+    }
+    return false;
+  }
+
+  /// Copies the directive starting at First (which points at '#') through
+  /// the end of its logical line into Out. Returns true on error.
+  bool lexDirective() {
+    assert(*First == '#');
+    const char *DirectiveBegin = First;
+    ++First;
+
+    // Find the directive name.
+    while (First != End) {
+      if (isHorizontalWhitespace(*First)) {
+        ++First;
+        continue;
+      }
+      if (unsigned Len = isEscapedNewline()) {
+        First += Len;
+        continue;
+      }
+      break;
+    }
+    const char *NameBegin = First;
+    while (First != End && isIdentifierBody(*First))
+      ++First;
+    StringRef Name(NameBegin, First - NameBegin);
+
+    // In include-like directives a '<' opens a header-name token, inside
+    // which comment and literal characters are not special.
+    bool IsIncludeLike = Name == "include" || Name == "include_next" ||
+                         Name == "import" || Name == "__include_macros";
+
+    while (First != End) {
+      char C = *First;
+      if (isVerticalWhitespace(C))
+        break;
+      if (unsigned Len = isEscapedNewline()) {
+        First += Len;
+        continue;
+      }
+      if (C == '<' && IsIncludeLike) {
+        ++First;
+        while (First != End && *First != '>' && !isVerticalWhitespace(*First))
+          ++First;
+        if (First != End && *First == '>')
+          ++First;
+        continue;
+      }
+      if (C == '\'') {
+        skipLiteral('\'');
+        continue;
+      }
+      if (C == '"') {
+        if (isAtRawStringQuote()) {
+          if (skipRawString())
+            return true;
+        } else {
+          skipLiteral('"');
+        }
+        continue;
+      }
+      if (C == '/' && First + 1 != End) {
+        if (First[1] == '/') {
+          skipLineComment();
+          continue;
+        }
+        if (First[1] == '*') {
+          if (skipBlockComment())
+            return true;
+          continue;
+        }
+      }
+      ++First;
+    }
+
+    Out.append(DirectiveBegin, First);
+    Out.push_back('\n');
+    if (First != End)
+      skipNewline();
+    return false;
+  }
+};
+
+} // end anonymous namespace
+
+bool Minimizer::minimize() {
+  while (First != End) {
+    if (skipToNextToken())
+      return true;
+    if (First == End)
+      break;
+    if (*First == '#') {
+      if (lexDirective())
+        return true;
+    } else if (skipLine()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool clang::minimizeSourceToDependencyDirectives(
+    StringRef Input, SmallVectorImpl<char> &Output) {
+  Output.clear();
+  return Minimizer(Output, Input).minimize();
+}
@@ -48,8 +48,64 @@
 #include <tuple>
 #include <utility>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif __ALTIVEC__
+#include <altivec.h>
+#undef bool
+#endif
+
 using namespace clang;
 
+#ifdef __SSE2__
+/// Returns a pointer to the first byte in [Start, End) that is not a plain
+/// ASCII identifier-body character [_0-9A-Za-z], scanning 16 bytes at a time.
+/// Bytes >= 0x80 (UCNs, UTF-8) stop the scan; the caller's scalar loop and
+/// slow path classify them.  May return early with fewer than 16 bytes left;
+/// the caller must finish with the scalar loop.
+static const char *scanIdentifierBodyVectorized(const char *Start,
+                                                const char *End) {
+  while (Start + 16 <= End) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Start));
+    // Signed compares treat bytes >= 0x80 as negative, so they fail the
+    // range checks below and correctly terminate the scan.
+    __m128i Digit = _mm_and_si128(_mm_cmpgt_epi8(Chunk, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(Chunk, _mm_set1_epi8('9' + 1)));
+    __m128i Lower = _mm_or_si128(Chunk, _mm_set1_epi8(0x20));
+    __m128i Alpha = _mm_and_si128(_mm_cmpgt_epi8(Lower, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmplt_epi8(Lower, _mm_set1_epi8('z' + 1)));
+    __m128i Under = _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('_'));
+    unsigned Mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_or_si128(Digit, Alpha), Under));
+    if (Mask != 0xFFFF)
+      return Start + llvm::countTrailingZeros<unsigned>(~Mask & 0xFFFF);
+    Start += 16;
+  }
+  return Start;
+}
+
+/// Returns a pointer to the first byte in [Start, End) that is not horizontal
+/// whitespace (' ', '\t', '\f', '\v'), scanning 16 bytes at a time.  May
+/// return early with fewer than 16 bytes left; the caller must finish with
+/// the scalar loop.
+static const char *scanHorizontalWhitespaceVectorized(const char *Start,
+                                                      const char *End) {
+  while (Start + 16 <= End) {
+    __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Start));
+    __m128i WS = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8(' ')),
+                     _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\t'))),
+        _mm_or_si128(_mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\f')),
+                     _mm_cmpeq_epi8(Chunk, _mm_set1_epi8('\v'))));
+    unsigned Mask = _mm_movemask_epi8(WS);
+    if (Mask != 0xFFFF)
+      return Start + llvm::countTrailingZeros<unsigned>(~Mask & 0xFFFF);
+    Start += 16;
+  }
+  return Start;
+}
+#endif // __SSE2__
+
 //===----------------------------------------------------------------------===//
 // Token Class Implementation
 //===----------------------------------------------------------------------===//
@@ -1631,6 +1687,15 @@ bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
   unsigned char C = *CurPtr++;
+#ifdef __SSE2__
+  // Long identifiers are common in expanded/mangled-heavy code; chew through
+  // the plain ASCII run 16 bytes at a time.  The NUL at BufferEnd and any
+  // code-completion NUL terminate the scan like any other non-body byte.
+  if (isIdentifierBody(C)) {
+    CurPtr = scanIdentifierBodyVectorized(CurPtr, BufferEnd);
+    C = *CurPtr++;
+  }
+#endif
   while (isIdentifierBody(C))
     C = *CurPtr++;
 
@@ -2184,6 +2249,15 @@ bool Lexer::SkipWhitespace(Token &Result, const char *CurPtr,
 
   // Skip consecutive spaces efficiently.
   while (true) {
+#ifdef __SSE2__
+    // Deeply indented machine-generated code produces long horizontal
+    // whitespace runs; skip them 16 bytes at a time.  The NUL at BufferEnd
+    // is not whitespace, so the scan cannot run off the buffer.
+    if (isHorizontalWhitespace(Char)) {
+      CurPtr = scanHorizontalWhitespaceVectorized(CurPtr + 1, BufferEnd);
+      Char = *CurPtr;
+    }
+#endif
     // Skip horizontal whitespace very aggressively.
     while (isHorizontalWhitespace(Char))
       Char = *++CurPtr;
@@ -2461,13 +2535,6 @@ static bool isEndOfBlockCommentWithEscapedNewLine(const char *CurPtr,
   return true;
 }
 
-#ifdef __SSE2__
-#include <emmintrin.h>
-#elif __ALTIVEC__
-#include <altivec.h>
-#undef bool
-#endif
-
 /// We have just read from input the / and * characters that started a comment.
 /// Read until we find the * and / characters that terminate the comment.
 /// Note that we don't bother decoding trigraphs or escaped newlines in block
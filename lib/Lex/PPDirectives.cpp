@@ -377,7 +377,12 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
   ++NumSkipped;
   assert(!CurTokenLexer && CurPPLexer && "Lexing a macro, not a file?");
 
-  if (PreambleConditionalStack.reachedEOFWhileSkipping())
+  // When a preamble ended mid-skip, we resume in the middle of the region
+  // with conditional levels restored from the preamble; the byte-offset skip
+  // cache below only understands skips that start at the '#if' itself.
+  bool ResumingFromPreambleEOF =
+      PreambleConditionalStack.reachedEOFWhileSkipping();
+  if (ResumingFromPreambleEOF)
     PreambleConditionalStack.clearSkipInfo();
   else
     CurPPLexer->pushConditionalLevel(IfTokenLoc, /*isSkipping*/ false,
@@ -391,6 +396,38 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
   // Enter raw mode to disable identifier lookup (and thus macro expansion),
   // disabling warnings, etc.
   CurPPLexer->LexingRawMode = true;
+
+  // If we have already skipped this exact block, and the earlier skip was
+  // purely lexical -- it arrived at a directive at the level of this
+  // conditional without evaluating any #elif condition and without emitting
+  // a diagnostic -- then its landing point is valid under any macro state.
+  // Jump straight there and let the loop below process that directive
+  // normally; this avoids re-lexing the excluded region every time an
+  // #ifdef-heavy header is re-entered.
+  const char *BlockBegin = nullptr;
+  bool RecordingSkip = false;
+  const char *LastHashPtr = nullptr;
+  unsigned SkipNestingLevel = 0;
+  unsigned DiagsAtStart = 0;
+  if (CurLexer && !ResumingFromPreambleEOF && !isCodeCompletionEnabled()) {
+    bool Invalid = false;
+    const char *Ptr = SourceMgr.getCharacterData(HashTokenLoc, &Invalid);
+    if (!Invalid && Ptr >= CurLexer->BufferStart && Ptr < CurLexer->BufferEnd) {
+      auto Known = SkippedExcludedBlockCache.find(Ptr);
+      if (Known != SkippedExcludedBlockCache.end()) {
+        assert(Known->second > Ptr && Known->second < CurLexer->BufferEnd &&
+               "cached skip target outside the current buffer");
+        CurLexer->SetByteOffset(Known->second - CurLexer->BufferStart,
+                                /*StartOfLine=*/true);
+        ++NumSkippedReplayed;
+      } else {
+        BlockBegin = Ptr;
+        RecordingSkip = true;
+        DiagsAtStart = Diags->getNumWarnings() + Diags->getNumErrors();
+      }
+    }
+  }
+
   Token Tok;
   while (true) {
     CurLexer->Lex(Tok);
@@ -417,6 +454,13 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
     if (Tok.isNot(tok::hash) || !Tok.isAtStartOfLine())
       continue;
 
+    if (RecordingSkip) {
+      bool Invalid = false;
+      LastHashPtr = SourceMgr.getCharacterData(Tok.getLocation(), &Invalid);
+      if (Invalid)
+        RecordingSkip = false;
+    }
+
     // We just parsed a # character at the start of a line, so we're in
     // directive mode.  Tell the lexer this so any newlines we see will be
     // converted into an EOD token (this terminates the macro).
@@ -472,6 +516,18 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
       Directive = StringRef(DirectiveBuf, IdLen);
     }
 
+    // The first #endif, #else or #elif at the level of this conditional ends
+    // the purely lexical part of the skip: whatever happens next may depend
+    // on macro state, so this is the point a later skip of the same block
+    // can safely fast-forward to.
+    if (RecordingSkip && SkipNestingLevel == 0 &&
+        (Directive == "endif" || Directive == "else" || Directive == "elif")) {
+      if (LastHashPtr && LastHashPtr > BlockBegin &&
+          Diags->getNumWarnings() + Diags->getNumErrors() == DiagsAtStart)
+        SkippedExcludedBlockCache.insert({BlockBegin, LastHashPtr});
+      RecordingSkip = false;
+    }
+
     if (Directive.startswith("if")) {
       StringRef Sub = Directive.substr(2);
       if (Sub.empty() ||   // "if"
@@ -483,6 +539,7 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
         CurPPLexer->pushConditionalLevel(Tok.getLocation(), /*wasskipping*/true,
                                        /*foundnonskip*/false,
                                        /*foundelse*/false);
+        ++SkipNestingLevel;
       }
     } else if (Directive[0] == 'e') {
       StringRef Sub = Directive.substr(1);
@@ -504,6 +561,8 @@ void Preprocessor::SkipExcludedConditionalBlock(SourceLocation HashTokenLoc,
             Callbacks->Endif(Tok.getLocation(), CondInfo.IfLoc);
           break;
         } else {
+          if (SkipNestingLevel)
+            --SkipNestingLevel;
           DiscardUntilEndOfDirective();
         }
       } else if (Sub == "lse") { // "else".
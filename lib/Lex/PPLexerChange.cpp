@@ -16,6 +16,7 @@
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/LexDiagnostic.h"
 #include "clang/Lex/MacroInfo.h"
@@ -121,6 +122,14 @@ void Preprocessor::EnterSourceFileWithLexer(Lexer *TheLexer,
   if (CurLexerKind != CLK_LexAfterModuleImport)
     CurLexerKind = CLK_Lexer;
 
+  // Open a time-trace event for this file; it stays open while nested
+  // includes, parsing and Sema work driven by this file's tokens run, so
+  // the trace attributes cumulative cost through the include stack.  The
+  // matching end is in HandleEndOfFile.  _Pragma lexers are not files.
+  if (timeTraceProfilerEnabled() && !CurLexer->Is_PragmaLexer)
+    timeTraceProfilerBegin("Source",
+                           SourceMgr.getBufferName(CurLexer->getFileLoc()));
+
   // Notify the client, if desired, that we are in a new source file.
   if (Callbacks && !CurLexer->Is_PragmaLexer) {
     SrcMgr::CharacteristicKind FileType =
@@ -146,6 +155,11 @@ void Preprocessor::EnterSourceFileWithPTH(PTHLexer *PL,
   if (CurLexerKind != CLK_LexAfterModuleImport)
     CurLexerKind = CLK_PTHLexer;
 
+  if (timeTraceProfilerEnabled())
+    timeTraceProfilerBegin("Source",
+                           SourceMgr.getBufferName(SourceMgr.getLocForStartOfFile(
+                               CurPPLexer->getFileID())));
+
   // Notify the client, if desired, that we are in a new source file.
   if (Callbacks) {
     FileID FID = CurPPLexer->getFileID();
@@ -491,6 +505,12 @@ bool Preprocessor::HandleEndOfFile(Token &Result, bool isEndOfMacro) {
             SourceMgr.getFileEntryForID(CurPPLexer->getFileID())))
       FoundPCHThroughHeader = true;
 
+    // Close this file's time-trace event.  Macro token streams and _Pragma
+    // lexers never opened one.
+    if (timeTraceProfilerEnabled() && !isEndOfMacro && CurPPLexer &&
+        !(CurLexer && CurLexer->Is_PragmaLexer))
+      timeTraceProfilerEnd();
+
     // We're done with the #included file.
     RemoveTopOfLexerStack();
 
@@ -522,6 +542,12 @@ bool Preprocessor::HandleEndOfFile(Token &Result, bool isEndOfMacro) {
     }
   }
 
+  // This is the end of the main file; close its time-trace event.  Under
+  // incremental processing the lexer stays live and more input may follow,
+  // so the event is left open there.
+  if (timeTraceProfilerEnabled() && !isIncrementalProcessingEnabled())
+    timeTraceProfilerEnd();
+
   // If this is the end of the main file, form an EOF token.
   if (CurLexer) {
     const char *EndPos = getCurLexerEndPos();
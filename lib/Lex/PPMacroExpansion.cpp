@@ -514,6 +514,13 @@ bool Preprocessor::HandleMacroExpandedIdentifier(Token &Identifier,
   // Notice that this macro has been used.
   markMacroAsUsed(MI);
 
+  if (CollectExpansionStats) {
+    MacroExpansionStats &Stats =
+        ExpansionStats[Identifier.getIdentifierInfo()];
+    ++Stats.NumExpansions;
+    Stats.NumReplacementTokens += MI->getNumTokens();
+  }
+
   // Remember where the token is expanded.
   SourceLocation ExpandLoc = Identifier.getLocation();
   SourceRange ExpansionRange(ExpandLoc, ExpansionEnd);
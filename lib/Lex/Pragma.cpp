@@ -116,6 +116,9 @@ void PragmaNamespace::HandlePragma(Preprocessor &PP,
     return;
   }
 
+  if (Tok.getIdentifierInfo())
+    PP.recordPragmaUse(Tok.getIdentifierInfo()->getName());
+
   // Otherwise, pass it down.
   Handler->HandlePragma(PP, Introducer, Tok);
 }
@@ -67,6 +67,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -278,7 +279,8 @@ void Preprocessor::PrintStats() {
   llvm::errs() << "  " << NumElse << " #else/#elif.\n";
   llvm::errs() << "  " << NumEndif << " #endif.\n";
   llvm::errs() << "  " << NumPragma << " #pragma.\n";
-  llvm::errs() << NumSkipped << " #if/#ifndef#ifdef regions skipped\n";
+  llvm::errs() << NumSkipped << " #if/#ifndef#ifdef regions skipped, "
+               << NumSkippedReplayed << " replayed from the skip cache\n";
 
   llvm::errs() << NumMacroExpanded << "/" << NumFnMacroExpanded << "/"
              << NumBuiltinMacroExpanded << " obj/fn/builtin macros expanded, "
@@ -287,6 +289,49 @@ void Preprocessor::PrintStats() {
              << " token paste (##) operations performed, "
              << NumFastTokenPaste << " on the fast path.\n";
 
+  if (CollectExpansionStats && !ExpansionStats.empty()) {
+    std::vector<std::pair<const IdentifierInfo *, MacroExpansionStats>>
+        Macros(ExpansionStats.begin(), ExpansionStats.end());
+    // Heaviest output volume first; break ties by name for stable output.
+    llvm::sort(Macros.begin(), Macros.end(),
+               [](const std::pair<const IdentifierInfo *,
+                                  MacroExpansionStats> &LHS,
+                  const std::pair<const IdentifierInfo *,
+                                  MacroExpansionStats> &RHS) {
+      if (LHS.second.NumReplacementTokens != RHS.second.NumReplacementTokens)
+        return LHS.second.NumReplacementTokens >
+               RHS.second.NumReplacementTokens;
+      return LHS.first->getName() < RHS.first->getName();
+    });
+    const unsigned MaxMacrosToReport = 32;
+    llvm::errs() << "\nTop macros by expanded token volume:\n";
+    for (unsigned I = 0, E = std::min<unsigned>(Macros.size(),
+                                                MaxMacrosToReport);
+         I != E; ++I)
+      llvm::errs() << "  " << Macros[I].first->getName() << ": "
+                   << Macros[I].second.NumExpansions << " expansions, "
+                   << Macros[I].second.NumReplacementTokens
+                   << " replacement tokens\n";
+  }
+
+  if (CollectPragmaStats && !PragmaUsageCounts.empty()) {
+    std::vector<std::pair<StringRef, unsigned>> Pragmas;
+    Pragmas.reserve(PragmaUsageCounts.size());
+    for (const auto &Entry : PragmaUsageCounts)
+      Pragmas.push_back(std::make_pair(Entry.getKey(), Entry.getValue()));
+    // Most dispatched first; break ties by name for stable output.
+    llvm::sort(Pragmas.begin(), Pragmas.end(),
+               [](const std::pair<StringRef, unsigned> &LHS,
+                  const std::pair<StringRef, unsigned> &RHS) {
+      if (LHS.second != RHS.second)
+        return LHS.second > RHS.second;
+      return LHS.first < RHS.first;
+    });
+    llvm::errs() << "\nPragma dispatches by name:\n";
+    for (const auto &P : Pragmas)
+      llvm::errs() << "  " << P.first << ": " << P.second << "\n";
+  }
+
   llvm::errs() << "\nPreprocessor Memory: " << getTotalMemory() << "B total";
 
   llvm::errs() << "\n  BumpPtr: " << BP.getTotalMemory();
@@ -328,6 +373,7 @@ size_t Preprocessor::getTotalMemory() const {
     + llvm::capacity_in_bytes(CurSubmoduleState->Macros)
     + llvm::capacity_in_bytes(PragmaPushMacroInfo)
     + llvm::capacity_in_bytes(PoisonReasons)
+    + llvm::capacity_in_bytes(InternedSpellings)
     + llvm::capacity_in_bytes(CommentHandlers);
 }
 
@@ -480,6 +526,29 @@ StringRef Preprocessor::getSpelling(const Token &Tok,
   return StringRef(Ptr, Len);
 }
 
+/// getSpellingInterned - Get the spelling of a token with storage that
+/// outlives the call. The common case is a token that needs no cleaning,
+/// whose spelling already exists in the identifier table or the source
+/// buffer; cleaned spellings are copied into the preprocessor allocator once
+/// and memoized by token location.
+StringRef Preprocessor::getSpellingInterned(const Token &Tok, bool *Invalid) {
+  SmallString<64> Buffer;
+  StringRef Spelling = getSpelling(Tok, Buffer, Invalid);
+
+  // If the spelling did not use the local buffer, it is a stable slice of
+  // memory we do not own; hand it out directly.
+  if (Spelling.data() != Buffer.data())
+    return Spelling;
+
+  StringRef &Interned = InternedSpellings[Tok.getLocation().getRawEncoding()];
+  if (Interned.empty()) {
+    char *Mem = static_cast<char *>(BP.Allocate(Spelling.size(), 1));
+    memcpy(Mem, Spelling.data(), Spelling.size());
+    Interned = StringRef(Mem, Spelling.size());
+  }
+  return Interned;
+}
+
 /// CreateString - Plop the specified string into a scratch buffer and return a
 /// location for it.  If specified, the source location provides a source
 /// location for the token.
@@ -16,6 +16,7 @@
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ExternalASTSource.h"
 #include "clang/AST/Stmt.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Parse/ParseDiagnostic.h"
 #include "clang/Parse/Parser.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
@@ -140,26 +141,34 @@ void clang::ParseAST(Sema &S, bool PrintStats, bool SkipFunctionBodies) {
   llvm::CrashRecoveryContextCleanupRegistrar<Parser>
     CleanupParser(ParseOP.get());
 
-  S.getPreprocessor().EnterMainSourceFile();
-  ExternalASTSource *External = S.getASTContext().getExternalSource();
-  if (External)
-    External->StartTranslationUnit(Consumer);
-
-  // If a PCH through header is specified that does not have an include in
-  // the source, or a PCH is being created with #pragma hdrstop with nothing
-  // after the pragma, there won't be any tokens or a Lexer.
-  bool HaveLexer = S.getPreprocessor().getCurrentLexer();
-
-  if (HaveLexer) {
-    P.Initialize();
-    Parser::DeclGroupPtrTy ADecl;
-    for (bool AtEOF = P.ParseFirstTopLevelDecl(ADecl); !AtEOF;
-         AtEOF = P.ParseTopLevelDecl(ADecl)) {
-      // If we got a null return and something *was* parsed, ignore it.  This
-      // is due to a top-level semicolon, an action override, or a parse error
-      // skipping something.
-      if (ADecl && !Consumer->HandleTopLevelDecl(ADecl.get()))
-        return;
+  // The "Frontend" event must enclose the per-file "Source" events the
+  // preprocessor opens, starting with the main file entered here; otherwise
+  // the begin/end pairs would not nest.
+  bool HaveLexer;
+  {
+    TimeTraceScope TimeScope("Frontend", StringRef(""));
+
+    S.getPreprocessor().EnterMainSourceFile();
+    ExternalASTSource *External = S.getASTContext().getExternalSource();
+    if (External)
+      External->StartTranslationUnit(Consumer);
+
+    // If a PCH through header is specified that does not have an include in
+    // the source, or a PCH is being created with #pragma hdrstop with nothing
+    // after the pragma, there won't be any tokens or a Lexer.
+    HaveLexer = S.getPreprocessor().getCurrentLexer();
+
+    if (HaveLexer) {
+      P.Initialize();
+      Parser::DeclGroupPtrTy ADecl;
+      for (bool AtEOF = P.ParseFirstTopLevelDecl(ADecl); !AtEOF;
+           AtEOF = P.ParseTopLevelDecl(ADecl)) {
+        // If we got a null return and something *was* parsed, ignore it.
+        // This is due to a top-level semicolon, an action override, or a
+        // parse error skipping something.
+        if (ADecl && !Consumer->HandleTopLevelDecl(ADecl.get()))
+          return;
+      }
     }
   }
 
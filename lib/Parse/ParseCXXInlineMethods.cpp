@@ -101,7 +101,7 @@ NamedDecl *Parser::ParseCXXInlineMethodDef(
 
   if (SkipFunctionBodies && (!FnD || Actions.canSkipFunctionBody(FnD)) &&
       trySkippingFunctionBody()) {
-    Actions.ActOnSkippedFunctionBody(FnD);
+    Actions.ActOnSkippedFunctionBody(FnD, PrevTokLocation);
     return FnD;
   }
 
@@ -133,7 +133,7 @@ static OpenMPDirectiveKind parseOpenMPDirectiveKind(Parser &P) {
   unsigned DKind =
       Tok.isAnnotation()
           ? static_cast<unsigned>(OMPD_unknown)
-          : getOpenMPDirectiveKindEx(P.getPreprocessor().getSpelling(Tok));
+          : getOpenMPDirectiveKindEx(P.getPreprocessor().getSpellingInterned(Tok));
   if (DKind == OMPD_unknown)
     return OMPD_unknown;
 
@@ -145,7 +145,7 @@ static OpenMPDirectiveKind parseOpenMPDirectiveKind(Parser &P) {
     unsigned SDKind =
         Tok.isAnnotation()
             ? static_cast<unsigned>(OMPD_unknown)
-            : getOpenMPDirectiveKindEx(P.getPreprocessor().getSpelling(Tok));
+            : getOpenMPDirectiveKindEx(P.getPreprocessor().getSpellingInterned(Tok));
     if (SDKind == OMPD_unknown)
       continue;
 
@@ -704,7 +704,7 @@ Parser::DeclGroupPtrTy Parser::ParseOpenMPDeclarativeDirectiveWithExtDecl(
     while (Tok.isNot(tok::annot_pragma_openmp_end)) {
       OpenMPClauseKind CKind = Tok.isAnnotation()
                                    ? OMPC_unknown
-                                   : getOpenMPClauseKind(PP.getSpelling(Tok));
+                                   : getOpenMPClauseKind(PP.getSpellingInterned(Tok));
       Actions.StartOpenMPClause(CKind);
       OMPClause *Clause =
           ParseOpenMPClause(OMPD_requires, CKind, !FirstClauses[CKind].getInt());
@@ -1123,7 +1123,7 @@ StmtResult Parser::ParseOpenMPDeclarativeOrExecutableDirective(
           Tok.isAnnotation()
               ? OMPC_unknown
               : FlushHasClause ? OMPC_flush
-                               : getOpenMPClauseKind(PP.getSpelling(Tok));
+                               : getOpenMPClauseKind(PP.getSpellingInterned(Tok));
       Actions.StartOpenMPClause(CKind);
       FlushHasClause = false;
       OMPClause *Clause =
@@ -1521,7 +1521,7 @@ OMPClause *Parser::ParseOpenMPSimpleClause(OpenMPClauseKind Kind,
     return nullptr;
 
   unsigned Type = getOpenMPSimpleClauseType(
-      Kind, Tok.isAnnotation() ? "" : PP.getSpelling(Tok));
+      Kind, Tok.isAnnotation() ? "" : PP.getSpellingInterned(Tok));
   SourceLocation TypeLoc = Tok.getLocation();
   if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::comma) &&
       Tok.isNot(tok::annot_pragma_openmp_end))
@@ -1607,7 +1607,7 @@ OMPClause *Parser::ParseOpenMPSingleExprWithArgClause(OpenMPClauseKind Kind,
     Arg[Modifier2] = OMPC_SCHEDULE_MODIFIER_unknown;
     Arg[ScheduleKind] = OMPC_SCHEDULE_unknown;
     unsigned KindModifier = getOpenMPSimpleClauseType(
-        Kind, Tok.isAnnotation() ? "" : PP.getSpelling(Tok));
+        Kind, Tok.isAnnotation() ? "" : PP.getSpellingInterned(Tok));
     if (KindModifier > OMPC_SCHEDULE_unknown) {
       // Parse 'modifier'
       Arg[Modifier1] = KindModifier;
@@ -1619,7 +1619,7 @@ OMPClause *Parser::ParseOpenMPSingleExprWithArgClause(OpenMPClauseKind Kind,
         // Parse ',' 'modifier'
         ConsumeAnyToken();
         KindModifier = getOpenMPSimpleClauseType(
-            Kind, Tok.isAnnotation() ? "" : PP.getSpelling(Tok));
+            Kind, Tok.isAnnotation() ? "" : PP.getSpellingInterned(Tok));
         Arg[Modifier2] = KindModifier > OMPC_SCHEDULE_unknown
                              ? KindModifier
                              : (unsigned)OMPC_SCHEDULE_unknown;
@@ -1634,7 +1634,7 @@ OMPClause *Parser::ParseOpenMPSingleExprWithArgClause(OpenMPClauseKind Kind,
       else
         Diag(Tok, diag::warn_pragma_expected_colon) << "schedule modifier";
       KindModifier = getOpenMPSimpleClauseType(
-          Kind, Tok.isAnnotation() ? "" : PP.getSpelling(Tok));
+          Kind, Tok.isAnnotation() ? "" : PP.getSpellingInterned(Tok));
     }
     Arg[ScheduleKind] = KindModifier;
     KLoc[ScheduleKind] = Tok.getLocation();
@@ -1648,7 +1648,7 @@ OMPClause *Parser::ParseOpenMPSingleExprWithArgClause(OpenMPClauseKind Kind,
       DelimLoc = ConsumeAnyToken();
   } else if (Kind == OMPC_dist_schedule) {
     Arg.push_back(getOpenMPSimpleClauseType(
-        Kind, Tok.isAnnotation() ? "" : PP.getSpelling(Tok)));
+        Kind, Tok.isAnnotation() ? "" : PP.getSpellingInterned(Tok)));
     KLoc.push_back(Tok.getLocation());
     if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::comma) &&
         Tok.isNot(tok::annot_pragma_openmp_end))
@@ -1658,7 +1658,7 @@ OMPClause *Parser::ParseOpenMPSingleExprWithArgClause(OpenMPClauseKind Kind,
   } else if (Kind == OMPC_defaultmap) {
     // Get a defaultmap modifier
     Arg.push_back(getOpenMPSimpleClauseType(
-        Kind, Tok.isAnnotation() ? "" : PP.getSpelling(Tok)));
+        Kind, Tok.isAnnotation() ? "" : PP.getSpellingInterned(Tok)));
     KLoc.push_back(Tok.getLocation());
     if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::comma) &&
         Tok.isNot(tok::annot_pragma_openmp_end))
@@ -1670,7 +1670,7 @@ OMPClause *Parser::ParseOpenMPSingleExprWithArgClause(OpenMPClauseKind Kind,
       Diag(Tok, diag::warn_pragma_expected_colon) << "defaultmap modifier";
     // Get a defaultmap kind
     Arg.push_back(getOpenMPSimpleClauseType(
-        Kind, Tok.isAnnotation() ? "" : PP.getSpelling(Tok)));
+        Kind, Tok.isAnnotation() ? "" : PP.getSpellingInterned(Tok)));
     KLoc.push_back(Tok.getLocation());
     if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::comma) &&
         Tok.isNot(tok::annot_pragma_openmp_end))
@@ -1808,7 +1808,7 @@ bool Parser::ParseOpenMPVarList(OpenMPDirectiveKind DKind,
     ColonProtectionRAIIObject ColonRAII(*this);
     Data.DepKind =
         static_cast<OpenMPDependClauseKind>(getOpenMPSimpleClauseType(
-            Kind, Tok.is(tok::identifier) ? PP.getSpelling(Tok) : ""));
+            Kind, Tok.is(tok::identifier) ? PP.getSpellingInterned(Tok) : ""));
     Data.DepLinMapLoc = Tok.getLocation();
 
     if (Data.DepKind == OMPC_DEPEND_unknown) {
@@ -1834,7 +1834,7 @@ bool Parser::ParseOpenMPVarList(OpenMPDirectiveKind DKind,
     // Try to parse modifier if any.
     if (Tok.is(tok::identifier) && PP.LookAhead(0).is(tok::l_paren)) {
       Data.LinKind = static_cast<OpenMPLinearClauseKind>(
-          getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok)));
+          getOpenMPSimpleClauseType(Kind, PP.getSpellingInterned(Tok)));
       Data.DepLinMapLoc = ConsumeToken();
       LinearT.consumeOpen();
       NeedRParenForLinear = true;
@@ -1855,7 +1855,7 @@ bool Parser::ParseOpenMPVarList(OpenMPDirectiveKind DKind,
     Data.MapType =
         IsMapClauseModifierToken(Tok)
             ? static_cast<OpenMPMapClauseKind>(
-                  getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok)))
+                  getOpenMPSimpleClauseType(Kind, PP.getSpellingInterned(Tok)))
             : OMPC_MAP_unknown;
     Data.DepLinMapLoc = Tok.getLocation();
     bool ColonExpected = false;
@@ -1884,7 +1884,7 @@ bool Parser::ParseOpenMPVarList(OpenMPDirectiveKind DKind,
           Data.MapType =
               IsMapClauseModifierToken(Tok)
                   ? static_cast<OpenMPMapClauseKind>(
-                        getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok)))
+                        getOpenMPSimpleClauseType(Kind, PP.getSpellingInterned(Tok)))
                   : OMPC_MAP_unknown;
           if (Data.MapType == OMPC_MAP_unknown ||
               Data.MapType == OMPC_MAP_always)
@@ -1909,7 +1909,7 @@ bool Parser::ParseOpenMPVarList(OpenMPDirectiveKind DKind,
           Data.MapType =
               IsMapClauseModifierToken(Tok)
                   ? static_cast<OpenMPMapClauseKind>(
-                        getOpenMPSimpleClauseType(Kind, PP.getSpelling(Tok)))
+                        getOpenMPSimpleClauseType(Kind, PP.getSpellingInterned(Tok)))
                   : OMPC_MAP_unknown;
           if (Data.MapType == OMPC_MAP_unknown ||
               Data.MapType == OMPC_MAP_always)
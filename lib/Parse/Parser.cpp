@@ -1118,7 +1118,7 @@ Decl *Parser::ParseFunctionDefinition(ParsingDeclarator &D,
     if (SkipFunctionBodies && (!DP || Actions.canSkipFunctionBody(DP)) &&
         trySkippingFunctionBody()) {
       BodyScope.Exit();
-      return Actions.ActOnSkippedFunctionBody(DP);
+      return Actions.ActOnSkippedFunctionBody(DP, PrevTokLocation);
     }
 
     CachedTokens Toks;
@@ -1218,7 +1218,7 @@ Decl *Parser::ParseFunctionDefinition(ParsingDeclarator &D,
   if (SkipFunctionBodies && (!Res || Actions.canSkipFunctionBody(Res)) &&
       trySkippingFunctionBody()) {
     BodyScope.Exit();
-    Actions.ActOnSkippedFunctionBody(Res);
+    Actions.ActOnSkippedFunctionBody(Res, PrevTokLocation);
     return Actions.ActOnFinishFunctionBody(Res, nullptr, false);
   }
 
@@ -17,6 +17,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/TokenConcatenation.h"
 #include "clang/Rewrite/Core/Rewriter.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -24,6 +25,39 @@
 #include <memory>
 using namespace clang;
 
+namespace clang {
+namespace html {
+
+/// Remembers the highlight insertions produced by the relexing passes for a
+/// given FileID so they can be replayed into a fresh RewriteBuffer without
+/// lexing or preprocessing the file again.  Syntax highlights are keyed by
+/// raw offsets into the unrewritten buffer; macro highlights keep the
+/// original SourceLocations so replay goes through the same expansion-range
+/// logic as the initial computation.
+class RelexRewriteCache {
+public:
+  struct SyntaxHighlight {
+    unsigned B, E;
+    std::string StartTag, EndTag;
+  };
+
+  struct MacroHighlight {
+    SourceLocation B, E;
+    std::string Expansion;
+    bool IsTokenRange;
+  };
+
+  llvm::DenseMap<FileID, std::vector<SyntaxHighlight>> SyntaxHighlights;
+  llvm::DenseMap<FileID, std::vector<MacroHighlight>> MacroHighlights;
+};
+
+} // end html namespace
+} // end clang namespace
+
+html::RelexRewriteCacheRef html::instantiateRelexRewriteCache() {
+  return std::make_shared<RelexRewriteCache>();
+}
+
 
 /// HighlightRange - Highlight a range in the source code with the specified
 /// start/end tags.  B/E must be in the same file.  This ensures that
@@ -424,13 +458,34 @@ input.spoilerhider:checked + label + .spoiler{
 /// information about keywords, macro expansions etc.  This uses the macro
 /// table state from the end of the file, so it won't be perfectly perfect,
 /// but it will be reasonably close.
-void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
+void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP,
+                           RelexRewriteCacheRef Cache) {
   RewriteBuffer &RB = R.getEditBuffer(FID);
 
   const SourceManager &SM = PP.getSourceManager();
   const llvm::MemoryBuffer *FromFile = SM.getBuffer(FID);
+  const char *BufferStart = FromFile->getBufferStart();
+
+  // If we already lexed this file for a previous rewrite, replay the edits.
+  if (Cache) {
+    auto CacheIt = Cache->SyntaxHighlights.find(FID);
+    if (CacheIt != Cache->SyntaxHighlights.end()) {
+      for (const RelexRewriteCache::SyntaxHighlight &H : CacheIt->second)
+        HighlightRange(RB, H.B, H.E, BufferStart, H.StartTag.c_str(),
+                       H.EndTag.c_str());
+      return;
+    }
+  }
+
+  std::vector<RelexRewriteCache::SyntaxHighlight> Highlights;
+  auto Highlight = [&](unsigned B, unsigned E, const char *StartTag,
+                       const char *EndTag) {
+    HighlightRange(RB, B, E, BufferStart, StartTag, EndTag);
+    if (Cache)
+      Highlights.push_back({B, E, StartTag, EndTag});
+  };
+
   Lexer L(FID, FromFile, SM, PP.getLangOpts());
-  const char *BufferStart = L.getBuffer().data();
 
   // Inform the preprocessor that we want to retain comments as tokens, so we
   // can highlight them.
@@ -457,13 +512,12 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
 
       // If this is a pp-identifier, for a keyword, highlight it as such.
       if (Tok.isNot(tok::identifier))
-        HighlightRange(RB, TokOffs, TokOffs+TokLen, BufferStart,
-                       "<span class='keyword'>", "</span>");
+        Highlight(TokOffs, TokOffs+TokLen, "<span class='keyword'>",
+                  "</span>");
       break;
     }
     case tok::comment:
-      HighlightRange(RB, TokOffs, TokOffs+TokLen, BufferStart,
-                     "<span class='comment'>", "</span>");
+      Highlight(TokOffs, TokOffs+TokLen, "<span class='comment'>", "</span>");
       break;
     case tok::utf8_string_literal:
       // Chop off the u part of u8 prefix
@@ -480,8 +534,8 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
       // FALL THROUGH.
     case tok::string_literal:
       // FIXME: Exclude the optional ud-suffix from the highlighted range.
-      HighlightRange(RB, TokOffs, TokOffs+TokLen, BufferStart,
-                     "<span class='string_literal'>", "</span>");
+      Highlight(TokOffs, TokOffs+TokLen, "<span class='string_literal'>",
+                "</span>");
       break;
     case tok::hash: {
       // If this is a preprocessor directive, all tokens to end of line are too.
@@ -498,8 +552,7 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
       }
 
       // Find end of line.  This is a hack.
-      HighlightRange(RB, TokOffs, TokEnd, BufferStart,
-                     "<span class='directive'>", "</span>");
+      Highlight(TokOffs, TokEnd, "<span class='directive'>", "</span>");
 
       // Don't skip the next token.
       continue;
@@ -508,15 +561,34 @@ void html::SyntaxHighlight(Rewriter &R, FileID FID, const Preprocessor &PP) {
 
     L.LexFromRawLexer(Tok);
   }
+
+  if (Cache)
+    Cache->SyntaxHighlights[FID] = std::move(Highlights);
 }
 
 /// HighlightMacros - This uses the macro table state from the end of the
 /// file, to re-expand macros and insert (into the HTML) information about the
 /// macro expansions.  This won't be perfectly perfect, but it will be
 /// reasonably close.
-void html::HighlightMacros(Rewriter &R, FileID FID, const Preprocessor& PP) {
-  // Re-lex the raw token stream into a token buffer.
+void html::HighlightMacros(Rewriter &R, FileID FID, const Preprocessor& PP,
+                           RelexRewriteCacheRef Cache) {
   const SourceManager &SM = PP.getSourceManager();
+
+  // If we already re-preprocessed this file for a previous rewrite, replay
+  // the expansion highlights without running the preprocessor again.
+  if (Cache) {
+    auto CacheIt = Cache->MacroHighlights.find(FID);
+    if (CacheIt != Cache->MacroHighlights.end()) {
+      for (const RelexRewriteCache::MacroHighlight &H : CacheIt->second)
+        HighlightRange(R, H.B, H.E, "<span class='macro'>",
+                       H.Expansion.c_str(), H.IsTokenRange);
+      return;
+    }
+  }
+
+  std::vector<RelexRewriteCache::MacroHighlight> Highlights;
+
+  // Re-lex the raw token stream into a token buffer.
   std::vector<Token> TokenStream;
 
   const llvm::MemoryBuffer *FromFile = SM.getBuffer(FID);
@@ -644,8 +716,15 @@ void html::HighlightMacros(Rewriter &R, FileID FID, const Preprocessor& PP) {
 
     HighlightRange(R, LLoc.getBegin(), LLoc.getEnd(), "<span class='macro'>",
                    Expansion.c_str(), LLoc.isTokenRange());
+
+    if (Cache)
+      Highlights.push_back({LLoc.getBegin(), LLoc.getEnd(),
+                            std::move(Expansion), LLoc.isTokenRange()});
   }
 
+  if (Cache)
+    Cache->MacroHighlights[FID] = std::move(Highlights);
+
   // Restore the preprocessor's old state.
   TmpPP.setDiagnostics(*OldDiags);
   TmpPP.setPragmasEnabled(PragmasPreviouslyEnabled);
@@ -47,9 +47,16 @@ DelayedDiagnostic::makeAvailability(AvailabilityResult AR,
   DD.AvailabilityData.Message = MessageData;
   DD.AvailabilityData.MessageLen = Msg.size();
 
-  DD.AvailabilityData.SelectorLocs = new SourceLocation[Locs.size()];
-  memcpy(DD.AvailabilityData.SelectorLocs, Locs.data(),
-         sizeof(SourceLocation) * Locs.size());
+  if (Locs.size() == 1) {
+    // The common case is a single use location, which Loc already holds;
+    // getAvailabilitySelectorLocs returns it directly rather than making a
+    // heap copy.  Multiple locations only occur for ObjC message sends.
+    DD.AvailabilityData.SelectorLocs = nullptr;
+  } else {
+    DD.AvailabilityData.SelectorLocs = new SourceLocation[Locs.size()];
+    memcpy(DD.AvailabilityData.SelectorLocs, Locs.data(),
+           sizeof(SourceLocation) * Locs.size());
+  }
   DD.AvailabilityData.NumSelectorLocs = Locs.size();
 
   DD.AvailabilityData.AR = AR;
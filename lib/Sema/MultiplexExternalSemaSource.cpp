@@ -191,6 +191,14 @@ bool MultiplexExternalSemaSource::layoutRecordType(const RecordDecl *Record,
   return false;
 }
 
+bool MultiplexExternalSemaSource::getImportedRecordLayout(
+    const RecordDecl *Record, ImportedRecordLayout &Layout) {
+  for(size_t i = 0; i < Sources.size(); ++i)
+    if (Sources[i]->getImportedRecordLayout(Record, Layout))
+      return true;
+  return false;
+}
+
 void MultiplexExternalSemaSource::
 getMemoryBufferSizes(MemoryBufferSizes &sizes) const {
   for(size_t i = 0; i < Sources.size(); ++i)
@@ -32,6 +32,7 @@
 #include "clang/Sema/Initialization.h"
 #include "clang/Sema/MultiplexExternalSemaSource.h"
 #include "clang/Sema/ObjCMethodList.h"
+#include "clang/Sema/Overload.h"
 #include "clang/Sema/Scope.h"
 #include "clang/Sema/ScopeInfo.h"
 #include "clang/Sema/SemaConsumer.h"
@@ -138,6 +139,11 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
       ArrayWithObjectsMethod(nullptr), NSDictionaryDecl(nullptr),
       DictionaryWithObjectsMethod(nullptr), GlobalNewDeleteDeclared(false),
       TUKind(TUKind), NumSFINAEErrors(0),
+      NumClassDefinitionsInstantiated(0), NumFunctionDefinitionsInstantiated(0),
+      NumFunctionDefinitionsReused(0), NumNameLookups(0),
+      NumCallExprsAnalyzed(0), NumTemplateIdsChecked(0),
+      NumOverloadResolutions(0), NumOverloadCandidatesConsidered(0),
+      MaxOverloadCandidates(0),
       FullyCheckedComparisonCategories(
           static_cast<unsigned>(ComparisonCategoryType::Last) + 1),
       AccessCheckingSFINAE(false), InNonInstantiationSFINAEContext(false),
@@ -420,6 +426,22 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumClassDefinitionsInstantiated
+               << " class definitions instantiated.\n";
+  llvm::errs() << NumFunctionDefinitionsInstantiated
+               << " function definitions instantiated, "
+               << NumFunctionDefinitionsReused
+               << " reused from an earlier instantiation or an AST file.\n";
+  llvm::errs() << NumNameLookups << " name lookups.\n";
+  llvm::errs() << NumCallExprsAnalyzed << " call expressions analyzed.\n";
+  llvm::errs() << NumTemplateIdsChecked << " template-ids checked.\n";
+  llvm::errs() << NumOverloadResolutions << " overload resolutions over "
+               << NumOverloadCandidatesConsidered << " candidates";
+  if (NumOverloadResolutions)
+    llvm::errs() << " ("
+                 << NumOverloadCandidatesConsidered / NumOverloadResolutions
+                 << " avg, " << MaxOverloadCandidates << " max per set)";
+  llvm::errs() << ".\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -1579,6 +1601,29 @@ void Sema::ActOnComment(SourceRange Comment) {
   if (!LangOpts.RetainCommentsFromSystemHeaders &&
       SourceMgr.isInSystemHeader(Comment.getBegin()))
     return;
+
+  // Plain "// ..." comments are by far the most common kind and are discarded
+  // by RawCommentList::addComment anyway (unless -fparse-all-comments).  Peek
+  // at the comment text to drop them here, before paying for RawComment
+  // construction, which decomposes both ends of the range to extract the text.
+  // A comment that arrives out of source order can displace already-stored
+  // comments inside addComment (this happens when an #include directive
+  // carries a comment), so the fast path only applies to in-order comments.
+  if (!LangOpts.CommentOpts.ParseAllComments) {
+    bool Invalid = false;
+    const char *Text = SourceMgr.getCharacterData(Comment.getBegin(), &Invalid);
+    // Text[1] is valid because a comment has at least two characters, and the
+    // buffer is NUL-terminated, so Text[2] is safe to read even for "//\n".
+    if (!Invalid && Text[1] == '/' && Text[2] != '/' && Text[2] != '!' &&
+        Text[2] != '<') {
+      ArrayRef<RawComment *> Stored = Context.getRawCommentList().getComments();
+      if (Stored.empty() ||
+          SourceMgr.isBeforeInTranslationUnit(Stored.back()->getBeginLoc(),
+                                              Comment.getBegin()))
+        return;
+    }
+  }
+
   RawComment RC(SourceMgr, Comment, LangOpts.CommentOpts, false);
   if (RC.isAlmostTrailingComment()) {
     SourceRange MagicMarkerRange(Comment.getBegin(),
@@ -12971,12 +12971,16 @@ bool Sema::canSkipFunctionBody(Decl *D) {
   return Consumer.shouldSkipFunctionBody(D);
 }
 
-Decl *Sema::ActOnSkippedFunctionBody(Decl *Decl) {
+Decl *Sema::ActOnSkippedFunctionBody(Decl *Decl, SourceLocation BodyEnd) {
   if (!Decl)
     return nullptr;
-  if (FunctionDecl *FD = Decl->getAsFunction())
+  if (FunctionDecl *FD = Decl->getAsFunction()) {
     FD->setHasSkippedBody();
-  else if (ObjCMethodDecl *MD = dyn_cast<ObjCMethodDecl>(Decl))
+    // Extend the declaration over the skipped tokens, so consumers that want
+    // to parse this body later can find its extent from the source range.
+    if (BodyEnd.isValid())
+      FD->setRangeEnd(BodyEnd);
+  } else if (ObjCMethodDecl *MD = dyn_cast<ObjCMethodDecl>(Decl))
     MD->setHasSkippedBody();
   return Decl;
 }
@@ -5831,14 +5831,14 @@ static void handleDeprecatedAttr(Sema &S, Decl *D, const ParsedAttr &AL) {
   if (AL.isDeclspecAttribute() || AL.isCXX11Attribute())
     checkAttributeAtMostNumArgs(S, AL, 1);
   else if (AL.isArgExpr(1) && AL.getArgAsExpr(1) &&
-           !S.checkStringLiteralArgumentAttr(AL, 1, Replacement))
-    return;
-
-  if (!S.getLangOpts().CPlusPlus14 && AL.isCXX11Attribute() && !AL.isGNUScope())
-    S.Diag(AL.getLoc(), diag::ext_cxx14_attr) << AL;
-
-  D->addAttr(::new (S.Context)
-                 DeprecatedAttr(AL.getRange(), S.Context, Str, Replacement,
+           !S.checkStringLiteralArgumentAttr(AL, 1, Replacement))
+    return;
+
+  if (!S.getLangOpts().CPlusPlus14 && AL.isCXX11Attribute() && !AL.isGNUScope())
+    S.Diag(AL.getLoc(), diag::ext_cxx14_attr) << AL;
+
+  D->addAttr(::new (S.Context)
+                 DeprecatedAttr(AL.getRange(), S.Context, Str, Replacement,
                                 AL.getAttributeSpellingListIndex()));
 }
 
@@ -7567,6 +7567,25 @@ static void EmitAvailabilityWarning(Sema &S, AvailabilityResult AR,
                                     const ObjCInterfaceDecl *UnknownObjCClass,
                                     const ObjCPropertyDecl *ObjCProperty,
                                     bool ObjCPropertyAccess) {
+  // Deprecation warnings are by far the most common availability diagnostic,
+  // and pooling one copies its message and selector locations.  The warning
+  // that would eventually be emitted is fully determined here, so if it is
+  // mapped to be ignored at this location there is no point in pooling (or,
+  // in the immediate case, computing fix-its for) a diagnostic that can only
+  // be dropped on the floor.  Unavailable and not-yet-introduced results are
+  // not filtered: the former is an error and the latter's treatment depends
+  // on the context the delayed pool is eventually popped in.
+  if (AR == AR_Deprecated) {
+    unsigned DiagID = !Message.empty() ? diag::warn_deprecated_message
+                      : UnknownObjCClass
+                          ? diag::warn_deprecated_fwdclass_message
+                          : ObjCPropertyAccess
+                                ? diag::warn_property_method_deprecated
+                                : diag::warn_deprecated;
+    if (S.getDiagnostics().isIgnored(DiagID, Locs.front()))
+      return;
+  }
+
   // Delay if we're currently parsing a declaration.
   if (S.DelayedDiagnostics.shouldDelayDiagnostics()) {
     S.DelayedDiagnostics.add(
@@ -1732,6 +1732,7 @@ NamedDecl *LookupResult::getAcceptableDeclSlow(NamedDecl *D) const {
 ///
 /// @returns \c true if lookup succeeded and false otherwise.
 bool Sema::LookupName(LookupResult &R, Scope *S, bool AllowBuiltinCreation) {
+  ++NumNameLookups;
   DeclarationName Name = R.getLookupName();
   if (!Name) return false;
 
@@ -2076,6 +2077,12 @@ bool Sema::LookupQualifiedName(LookupResult &R, DeclContext *LookupCtx,
     return false;
   }
 
+  // If the hierarchy's member-name filter proves the name absent from this
+  // class and every base, skip the base walk (and the lazy construction of
+  // each base's lookup table) entirely.
+  if (!LookupRec->mayContainMemberName(R.getLookupName()))
+    return false;
+
   // Perform lookup into our base classes.
   CXXBasePaths Paths;
   Paths.setOrigin(LookupRec);
@@ -839,6 +839,12 @@ llvm::Optional<unsigned> DeductionFailureInfo::getCallArgIndex() {
   }
 }
 
+OverloadCandidateSetSlabPool &Sema::getOverloadSlabPool() {
+  if (!OverloadSlabPool)
+    OverloadSlabPool = llvm::make_unique<OverloadCandidateSetSlabPool>();
+  return *OverloadSlabPool;
+}
+
 void OverloadCandidateSet::destroyCandidates() {
   for (iterator i = begin(), e = end(); i != e; ++i) {
     for (auto &C : i->Conversions)
@@ -1242,7 +1248,8 @@ TryUserDefinedConversion(Sema &S, Expr *From, QualType ToType,
 
   // Attempt user-defined conversion.
   OverloadCandidateSet Conversions(From->getExprLoc(),
-                                   OverloadCandidateSet::CSK_Normal);
+                                   OverloadCandidateSet::CSK_Normal,
+                                   &S.getOverloadSlabPool());
   switch (IsUserDefinedConversion(S, From, ToType, ICS.UserDefined,
                                   Conversions, AllowExplicit,
                                   AllowObjCConversionOnExplicit)) {
@@ -3491,7 +3498,8 @@ bool
 Sema::DiagnoseMultipleUserDefinedConversion(Expr *From, QualType ToType) {
   ImplicitConversionSequence ICS;
   OverloadCandidateSet CandidateSet(From->getExprLoc(),
-                                    OverloadCandidateSet::CSK_Normal);
+                                    OverloadCandidateSet::CSK_Normal,
+                                    &getOverloadSlabPool());
   OverloadingResult OvResult =
     IsUserDefinedConversion(*this, From, ToType, ICS.UserDefined,
                             CandidateSet, false, false);
@@ -4342,7 +4350,8 @@ FindConversionForRefInit(Sema &S, ImplicitConversionSequence &ICS,
     = dyn_cast<CXXRecordDecl>(T2->getAs<RecordType>()->getDecl());
 
   OverloadCandidateSet CandidateSet(
-      DeclLoc, OverloadCandidateSet::CSK_InitByUserDefinedConversion);
+      DeclLoc, OverloadCandidateSet::CSK_InitByUserDefinedConversion,
+      &S.getOverloadSlabPool());
   const auto &Conversions = T2RecordDecl->getVisibleConversionFunctions();
   for (auto I = Conversions.begin(), E = Conversions.end(); I != E; ++I) {
     NamedDecl *D = *I;
@@ -5817,7 +5826,8 @@ ExprResult Sema::PerformContextualImplicitConversion(
     // If one unique T is found:
     // First, build a candidate set from the previously recorded
     // potentially viable conversions.
-    OverloadCandidateSet CandidateSet(Loc, OverloadCandidateSet::CSK_Normal);
+    OverloadCandidateSet CandidateSet(Loc, OverloadCandidateSet::CSK_Normal,
+                                      &getOverloadSlabPool());
     collectViableConversionCandidates(*this, From, ToType, ViableConversions,
                                       CandidateSet);
 
@@ -9292,6 +9302,11 @@ void Sema::diagnoseEquivalentInternalLinkageDeclarations(
 OverloadingResult
 OverloadCandidateSet::BestViableFunction(Sema &S, SourceLocation Loc,
                                          iterator &Best) {
+  ++S.NumOverloadResolutions;
+  S.NumOverloadCandidatesConsidered += size();
+  S.MaxOverloadCandidates =
+      std::max(S.MaxOverloadCandidates, unsigned(size()));
+
   llvm::SmallVector<OverloadCandidate *, 16> Candidates;
   std::transform(begin(), end(), std::back_inserter(Candidates),
                  [](OverloadCandidate &Cand) { return &Cand; });
@@ -11707,7 +11722,8 @@ DiagnoseTwoPhaseLookup(Sema &SemaRef, SourceLocation FnLoc,
         return false;
       }
 
-      OverloadCandidateSet Candidates(FnLoc, CSK);
+      OverloadCandidateSet Candidates(FnLoc, CSK,
+                                      &SemaRef.getOverloadSlabPool());
       for (LookupResult::iterator I = R.begin(), E = R.end(); I != E; ++I)
         AddOverloadedCallCandidate(SemaRef, I.getPair(),
                                    ExplicitTemplateArgs, Args,
@@ -12074,7 +12090,8 @@ ExprResult Sema::BuildOverloadedCallExpr(Scope *S, Expr *Fn,
                                          bool AllowTypoCorrection,
                                          bool CalleesAddressIsTaken) {
   OverloadCandidateSet CandidateSet(Fn->getExprLoc(),
-                                    OverloadCandidateSet::CSK_Normal);
+                                    OverloadCandidateSet::CSK_Normal,
+                                    &getOverloadSlabPool());
   ExprResult result;
 
   if (buildOverloadedCallSet(S, Fn, ULE, Args, LParenLoc, &CandidateSet,
@@ -12161,7 +12178,8 @@ Sema::CreateOverloadedUnaryOp(SourceLocation OpLoc, UnaryOperatorKind Opc,
   }
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(OpLoc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(OpLoc, OverloadCandidateSet::CSK_Operator,
+                                    &getOverloadSlabPool());
 
   // Add the candidates from the given function set.
   AddFunctionCandidates(Fns, ArgsArray, CandidateSet);
@@ -12376,7 +12394,8 @@ Sema::CreateOverloadedBinOp(SourceLocation OpLoc,
     return CreateBuiltinBinOp(OpLoc, Opc, Args[0], Args[1]);
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(OpLoc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(OpLoc, OverloadCandidateSet::CSK_Operator,
+                                    &getOverloadSlabPool());
 
   // Add the candidates from the given function set.
   AddFunctionCandidates(Fns, Args, CandidateSet);
@@ -12622,7 +12641,8 @@ Sema::CreateOverloadedArraySubscriptExpr(SourceLocation LLoc,
     return ExprError();
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(LLoc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(LLoc, OverloadCandidateSet::CSK_Operator,
+                                    &getOverloadSlabPool());
 
   // Subscript can only be overloaded as a member function.
 
@@ -12855,7 +12875,8 @@ Sema::BuildCallToMemberFunction(Scope *S, Expr *MemExprE,
 
     // Add overload candidates
     OverloadCandidateSet CandidateSet(UnresExpr->getMemberLoc(),
-                                      OverloadCandidateSet::CSK_Normal);
+                                      OverloadCandidateSet::CSK_Normal,
+                                      &getOverloadSlabPool());
 
     // FIXME: avoid copy.
     TemplateArgumentListInfo TemplateArgsBuffer, *TemplateArgs = nullptr;
@@ -13069,7 +13090,8 @@ Sema::BuildCallToObjectOfClassType(Scope *S, Expr *Obj,
   //  ordinary lookup of the name operator() in the context of
   //  (E).operator().
   OverloadCandidateSet CandidateSet(LParenLoc,
-                                    OverloadCandidateSet::CSK_Operator);
+                                    OverloadCandidateSet::CSK_Operator,
+                                    &getOverloadSlabPool());
   DeclarationName OpName = Context.DeclarationNames.getCXXOperatorName(OO_Call);
 
   if (RequireCompleteType(LParenLoc, Object.get()->getType(),
@@ -13341,7 +13363,8 @@ Sema::BuildOverloadedArrowExpr(Scope *S, Expr *Base, SourceLocation OpLoc,
   //   overload resolution mechanism (13.3).
   DeclarationName OpName =
     Context.DeclarationNames.getCXXOperatorName(OO_Arrow);
-  OverloadCandidateSet CandidateSet(Loc, OverloadCandidateSet::CSK_Operator);
+  OverloadCandidateSet CandidateSet(Loc, OverloadCandidateSet::CSK_Operator,
+                                    &getOverloadSlabPool());
   const RecordType *BaseRecord = Base->getType()->getAs<RecordType>();
 
   if (RequireCompleteType(Loc, Base->getType(),
@@ -13448,7 +13471,8 @@ ExprResult Sema::BuildLiteralOperatorCall(LookupResult &R,
   SourceLocation UDSuffixLoc = SuffixInfo.getCXXLiteralOperatorNameLoc();
 
   OverloadCandidateSet CandidateSet(UDSuffixLoc,
-                                    OverloadCandidateSet::CSK_Normal);
+                                    OverloadCandidateSet::CSK_Normal,
+                                    &getOverloadSlabPool());
   AddFunctionCandidates(R.asUnresolvedSet(), Args, CandidateSet, TemplateArgs,
                         /*SuppressUserConversions=*/true);
 
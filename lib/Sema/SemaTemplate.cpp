@@ -3101,6 +3101,7 @@ Sema::findFailedBooleanCondition(Expr *Cond, bool AllowTopLevelCond) {
 QualType Sema::CheckTemplateIdType(TemplateName Name,
                                    SourceLocation TemplateLoc,
                                    TemplateArgumentListInfo &TemplateArgs) {
+  ++NumTemplateIdsChecked;
   DependentTemplateName *DTN
     = Name.getUnderlying().getAsDependentTemplateName();
   if (DTN && DTN->isIdentifier())
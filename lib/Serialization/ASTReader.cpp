@@ -58,6 +58,7 @@
 #include "clang/Basic/SourceManagerInternals.h"
 #include "clang/Basic/Specifiers.h"
 #include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Basic/TargetOptions.h"
 #include "clang/Basic/TokenKinds.h"
 #include "clang/Basic/Version.h"
@@ -103,6 +104,7 @@
 #include "llvm/ADT/iterator_range.h"
 #include "llvm/Bitcode/BitstreamReader.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/DJB.h"
@@ -113,7 +115,9 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SaveAndRestore.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/Timer.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Support/VersionTuple.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -122,6 +126,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <ctime>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -137,6 +142,12 @@ using namespace clang::serialization;
 using namespace clang::serialization::reader;
 using llvm::BitstreamCursor;
 
+static llvm::cl::opt<std::string> DeserializationTraceFile(
+    "deserialization-trace-file", llvm::cl::Hidden,
+    llvm::cl::desc("Append a collapsed-stack trace of AST declaration reads "
+                   "to the given file, one 'outer;...;inner 1' line per read, "
+                   "suitable for flamegraph tools"));
+
 //===----------------------------------------------------------------------===//
 // ChainedASTReaderListener implementation
 //===----------------------------------------------------------------------===//
@@ -2088,6 +2099,7 @@ ASTReader::readInputFileInfo(ModuleFile &F, unsigned ID) {
   R.Overridden = static_cast<bool>(Record[3]);
   R.Transient = static_cast<bool>(Record[4]);
   R.TopLevelModuleMap = static_cast<bool>(Record[5]);
+  R.ContentHash = Record.size() > 6 ? Record[6] : 0;
   R.Filename = Blob;
   ResolveImportedPath(F, R.Filename);
   return R;
@@ -2180,6 +2192,20 @@ InputFile ASTReader::getInputFile(ModuleFile &F, unsigned ID, bool Complain) {
        (StoredTime && StoredTime != File->getModificationTime() &&
         !DisableValidation)
        )) {
+    // A timestamp mismatch with a matching size is frequently a false
+    // positive (checkout storms, build-farm clock skew).  If the writer
+    // recorded a content hash, revalidate by content before declaring the
+    // AST file out of date.
+    if (StoredSize == File->getSize() && FI.ContentHash != 0) {
+      auto MemBuffOrError = FileMgr.getBufferForFile(File);
+      if (MemBuffOrError &&
+          llvm::xxHash64((*MemBuffOrError)->getBuffer()) == FI.ContentHash) {
+        F.InputFilesLoaded[ID - 1] = InputFile(File, /*isOverridden=*/false,
+                                               /*isOutOfDate=*/false);
+        return F.InputFilesLoaded[ID - 1];
+      }
+    }
+
     if (Complain) {
       // Build a list of the PCH imports that got us here (in reverse).
       SmallVector<ModuleFile *, 4> ImportStack(1, &F);
@@ -2326,6 +2352,71 @@ ASTReader::ASTReadResult ASTReader::ReadOptionsBlock(
   }
 }
 
+namespace {
+
+/// One entry of a module file's import table, decoded from an IMPORTS record.
+struct UnresolvedModuleImport {
+  ModuleKind Kind;
+  SourceLocation ImportLoc;
+  off_t StoredSize;
+  time_t StoredModTime;
+  ASTFileSignature StoredSignature;
+  std::string FileName;
+};
+
+} // namespace
+
+/// Read the contents of the given module files into the module cache on
+/// background threads, so that loading them afterwards finds their bytes
+/// already in memory instead of faulting them in one file at a time.
+///
+/// The worker threads only ever touch their own llvm::MemoryBuffer; the cache
+/// itself is consulted and populated on the calling thread, after all reads
+/// have finished. Validation is unaffected: ReadASTCore still stats each
+/// file, checks its size and modification time, and verifies the stored
+/// signature against whatever buffer it ends up with, whether that buffer
+/// came from this prefetch or from a synchronous read.
+static void
+prefetchModuleFileBuffers(MemoryBufferCache &PCMCache,
+                          ArrayRef<UnresolvedModuleImport> Imports) {
+  if (!llvm::llvm_is_multithreaded())
+    return;
+
+  SmallVector<const UnresolvedModuleImport *, 4> Candidates;
+  for (const UnresolvedModuleImport &Import : Imports)
+    if (Import.FileName != "-" && !PCMCache.lookupBuffer(Import.FileName))
+      Candidates.push_back(&Import);
+
+  // A single outstanding read gains nothing over the synchronous path.
+  if (Candidates.size() < 2)
+    return;
+
+  SmallVector<
+      std::future<llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>>, 4>
+      Reads;
+  for (const UnresolvedModuleImport *Import : Candidates)
+    Reads.push_back(std::async(std::launch::async, [Import] {
+      return llvm::MemoryBuffer::getFile(Import->FileName, /*FileSize=*/-1,
+                                         /*RequiresNullTerminator=*/false);
+    }));
+
+  for (unsigned I = 0, N = Reads.size(); I != N; ++I) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> Buf = Reads[I].get();
+    // Leave failures for the load path to diagnose.
+    if (!Buf)
+      continue;
+    // If the file does not have the expected size the load will reject it as
+    // out of date; don't publish a buffer for it.
+    if (Candidates[I]->StoredSize != 0 &&
+        (off_t)(*Buf)->getBufferSize() != Candidates[I]->StoredSize)
+      continue;
+    // The import table can name the same file more than once.
+    if (PCMCache.lookupBuffer(Candidates[I]->FileName))
+      continue;
+    PCMCache.addBuffer(Candidates[I]->FileName, std::move(*Buf));
+  }
+}
+
 ASTReader::ASTReadResult
 ASTReader::ReadControlBlock(ModuleFile &F,
                             SmallVectorImpl<ImportedModule> &Loaded,
@@ -2530,40 +2621,49 @@ ASTReader::ReadControlBlock(ModuleFile &F,
       if (ASTReadResult Result = readUnhashedControlBlockOnce())
         return Result;
 
-      // Load each of the imported PCH files.
+      // Decode the whole import table before loading anything, so that we
+      // know every file we are about to touch up front.
+      SmallVector<UnresolvedModuleImport, 4> Imports;
       unsigned Idx = 0, N = Record.size();
       while (Idx < N) {
         // Read information about the AST file.
-        ModuleKind ImportedKind = (ModuleKind)Record[Idx++];
+        UnresolvedModuleImport Import;
+        Import.Kind = (ModuleKind)Record[Idx++];
         // The import location will be the local one for now; we will adjust
         // all import locations of module imports after the global source
         // location info are setup, in ReadAST.
-        SourceLocation ImportLoc =
-            ReadUntranslatedSourceLocation(Record[Idx++]);
-        off_t StoredSize = (off_t)Record[Idx++];
-        time_t StoredModTime = (time_t)Record[Idx++];
-        ASTFileSignature StoredSignature = {
+        Import.ImportLoc = ReadUntranslatedSourceLocation(Record[Idx++]);
+        Import.StoredSize = (off_t)Record[Idx++];
+        Import.StoredModTime = (time_t)Record[Idx++];
+        Import.StoredSignature = {
             {{(uint32_t)Record[Idx++], (uint32_t)Record[Idx++],
               (uint32_t)Record[Idx++], (uint32_t)Record[Idx++],
               (uint32_t)Record[Idx++]}}};
 
         std::string ImportedName = ReadString(Record, Idx);
-        std::string ImportedFile;
 
         // For prebuilt and explicit modules first consult the file map for
         // an override. Note that here we don't search prebuilt module
         // directories, only the explicit name to file mappings. Also, we will
         // still verify the size/signature making sure it is essentially the
         // same file but perhaps in a different location.
-        if (ImportedKind == MK_PrebuiltModule || ImportedKind == MK_ExplicitModule)
-          ImportedFile = PP.getHeaderSearchInfo().getPrebuiltModuleFileName(
+        if (Import.Kind == MK_PrebuiltModule || Import.Kind == MK_ExplicitModule)
+          Import.FileName = PP.getHeaderSearchInfo().getPrebuiltModuleFileName(
             ImportedName, /*FileMapOnly*/ true);
 
-        if (ImportedFile.empty())
-          ImportedFile = ReadPath(F, Record, Idx);
+        if (Import.FileName.empty())
+          Import.FileName = ReadPath(F, Record, Idx);
         else
           SkipPath(Record, Idx);
 
+        Imports.push_back(std::move(Import));
+      }
+
+      // Overlap the reads of sibling imports that are not in memory yet.
+      prefetchModuleFileBuffers(PCMCache, Imports);
+
+      // Load each of the imported PCH files.
+      for (const UnresolvedModuleImport &Import : Imports) {
         // If our client can't cope with us being out of date, we can't cope with
         // our dependency being missing.
         unsigned Capabilities = ClientLoadCapabilities;
@@ -2571,9 +2671,10 @@ ASTReader::ReadControlBlock(ModuleFile &F,
           Capabilities &= ~ARR_Missing;
 
         // Load the AST file.
-        auto Result = ReadASTCore(ImportedFile, ImportedKind, ImportLoc, &F,
-                                  Loaded, StoredSize, StoredModTime,
-                                  StoredSignature, Capabilities);
+        auto Result = ReadASTCore(Import.FileName, Import.Kind,
+                                  Import.ImportLoc, &F, Loaded,
+                                  Import.StoredSize, Import.StoredModTime,
+                                  Import.StoredSignature, Capabilities);
 
         // If we diagnosed a problem, produce a backtrace.
         if (isDiagnosedResult(Result, Capabilities))
@@ -3252,6 +3353,55 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
       break;
     }
 
+    case RECORD_LAYOUTS: {
+      // Stash each entry with its declaration IDs translated to global IDs;
+      // the first-loaded layout for a record wins.
+      unsigned Idx = 0;
+      while (Idx < Record.size()) {
+        serialization::DeclID ID = getGlobalDeclID(F, Record[Idx++]);
+        SmallVector<uint64_t, 16> &Layout = ImportedRecordLayouts[ID];
+        bool Known = !Layout.empty();
+        auto Copy = [&](uint64_t Value) {
+          if (!Known)
+            Layout.push_back(Value);
+        };
+        auto CopyN = [&](uint64_t N) {
+          while (N--)
+            Copy(Record[Idx++]);
+        };
+        auto CopyDeclRef = [&] {
+          uint64_t LocalID = Record[Idx++];
+          Copy(LocalID ? getGlobalDeclID(F, LocalID) : 0);
+        };
+
+        CopyN(5); // Size, data size, alignments.
+        uint64_t NumFields = Record[Idx];
+        Copy(Record[Idx++]);
+        CopyN(NumFields);
+        uint64_t IsCXX = Record[Idx];
+        Copy(Record[Idx++]);
+        if (IsCXX) {
+          CopyN(5); // Non-virtual size/alignment, empty subobject,
+                    // vbptr offset, flags.
+          CopyDeclRef(); // Primary base.
+          CopyDeclRef(); // Base sharing vbptr.
+          uint64_t NumBases = Record[Idx];
+          Copy(Record[Idx++]);
+          while (NumBases--) {
+            CopyDeclRef();
+            CopyN(1);
+          }
+          uint64_t NumVBases = Record[Idx];
+          Copy(Record[Idx++]);
+          while (NumVBases--) {
+            CopyDeclRef();
+            CopyN(2);
+          }
+        }
+      }
+      break;
+    }
+
     case DECL_UPDATE_OFFSETS:
       if (Record.size() % 2 != 0) {
         Error("invalid DECL_UPDATE_OFFSETS block in AST file");
@@ -3870,6 +4020,8 @@ ASTReader::ASTReadResult ASTReader::ReadAST(StringRef FileName,
   llvm::SaveAndRestore<SourceLocation>
     SetCurImportLocRAII(CurrentImportLoc, ImportLoc);
 
+  TimeTraceScope TimeScope("ReadAST", FileName);
+
   // Defer any pending actions until we get to the end of reading the AST file.
   Deserializing AnASTFile(this);
 
@@ -7156,6 +7308,77 @@ void ASTReader::CompleteRedeclChain(const Decl *D) {
   }
 }
 
+bool ASTReader::getImportedRecordLayout(const RecordDecl *Record,
+                                        ImportedRecordLayout &Layout) {
+  if (!Record->isFromASTFile())
+    return false;
+
+  auto It = ImportedRecordLayouts.find(Record->getGlobalID());
+  if (It == ImportedRecordLayouts.end())
+    return false;
+
+  // Copy the payload: resolving base classes below can deserialize decls,
+  // which may invalidate the map entry's address.
+  SmallVector<uint64_t, 32> Data(It->second.begin(), It->second.end());
+  unsigned Idx = 0;
+  auto ReadChars = [&] {
+    return CharUnits::fromQuantity((int64_t)Data[Idx++]);
+  };
+  bool Failed = false;
+  auto ReadBase = [&]() -> const CXXRecordDecl * {
+    uint64_t ID = Data[Idx++];
+    if (!ID)
+      return nullptr;
+    const auto *Base = dyn_cast_or_null<CXXRecordDecl>(GetDecl(ID));
+    if (!Base)
+      Failed = true;
+    return Base;
+  };
+
+  Layout.Size = ReadChars();
+  Layout.DataSize = ReadChars();
+  Layout.Alignment = ReadChars();
+  Layout.UnadjustedAlignment = ReadChars();
+  Layout.RequiredAlignment = ReadChars();
+  uint64_t NumFields = Data[Idx++];
+  Layout.FieldOffsets.append(Data.begin() + Idx, Data.begin() + Idx + NumFields);
+  Idx += NumFields;
+  Layout.IsCXX = Data[Idx++];
+  if (!Layout.IsCXX)
+    return true;
+
+  Layout.NonVirtualSize = ReadChars();
+  Layout.NonVirtualAlignment = ReadChars();
+  Layout.SizeOfLargestEmptySubobject = ReadChars();
+  Layout.VBPtrOffset = ReadChars();
+  uint64_t Flags = Data[Idx++];
+  Layout.HasOwnVFPtr = Flags & 0x1;
+  Layout.HasExtendableVFPtr = Flags & 0x2;
+  Layout.EndsWithZeroSizedObject = Flags & 0x4;
+  Layout.LeadsWithZeroSizedBase = Flags & 0x8;
+  Layout.PrimaryBaseIsVirtual = Flags & 0x10;
+  Layout.PrimaryBase = ReadBase();
+  Layout.BaseSharingVBPtr = ReadBase();
+
+  uint64_t NumBases = Data[Idx++];
+  while (NumBases--) {
+    ImportedRecordLayout::BaseInfo Base;
+    Base.Base = ReadBase();
+    Base.Offset = ReadChars();
+    Base.HasVtorDisp = false;
+    Layout.Bases.push_back(Base);
+  }
+  uint64_t NumVBases = Data[Idx++];
+  while (NumVBases--) {
+    ImportedRecordLayout::BaseInfo Base;
+    Base.Base = ReadBase();
+    Base.Offset = ReadChars();
+    Base.HasVtorDisp = Data[Idx++];
+    Layout.VBases.push_back(Base);
+  }
+  return !Failed;
+}
+
 CXXCtorInitializer **
 ASTReader::GetExternalCXXCtorInitializers(uint64_t Offset) {
   RecordLocation Loc = getLocalBitOffset(Offset);
@@ -7348,7 +7571,22 @@ Decl *ASTReader::GetDecl(DeclID ID) {
   }
 
   if (!DeclsLoaded[Index]) {
-    ReadDeclRecord(ID);
+    // A read that starts while nothing else is deserializing was triggered
+    // directly by a consumer request; everything nested below it is read
+    // amplification.
+    if (NumCurrentElementsDeserializing == 0)
+      ++NumDeclReadsRequested;
+    else
+      ++NumCascadedDeclReads;
+
+    if (!DeserializationTraceFile.empty()) {
+      DeserializationTraceStack.push_back(Index);
+      ReadDeclRecord(ID);
+      writeDeserializationTraceLine();
+      DeserializationTraceStack.pop_back();
+    } else {
+      ReadDeclRecord(ID);
+    }
     if (DeserializationListener)
       DeserializationListener->DeclRead(ID, DeclsLoaded[Index]);
   }
@@ -7356,6 +7594,42 @@ Decl *ASTReader::GetDecl(DeclID ID) {
   return DeclsLoaded[Index];
 }
 
+void ASTReader::writeDeserializationTraceLine() {
+  if (!DeserializationTraceOS) {
+    if (DeserializationTraceFailed)
+      return;
+    std::error_code EC;
+    DeserializationTraceOS = llvm::make_unique<llvm::raw_fd_ostream>(
+        DeserializationTraceFile, EC,
+        llvm::sys::fs::F_Append | llvm::sys::fs::F_Text);
+    if (EC) {
+      DeserializationTraceOS.reset();
+      DeserializationTraceFailed = true;
+      return;
+    }
+  }
+
+  llvm::raw_ostream &OS = *DeserializationTraceOS;
+  for (unsigned I = 0, N = DeserializationTraceStack.size(); I != N; ++I) {
+    if (I)
+      OS << ';';
+    // Enclosing frames may still be mid-read; their decls exist but may
+    // not be fully initialized, so only kind and name are used.
+    Decl *D = DeclsLoaded[DeserializationTraceStack[I]];
+    if (!D) {
+      OS << "<reading>";
+      continue;
+    }
+    OS << D->getDeclKindName();
+    if (auto *ND = dyn_cast<NamedDecl>(D)) {
+      std::string Name = ND->getNameAsString();
+      if (!Name.empty())
+        OS << ' ' << Name;
+    }
+  }
+  OS << " 1\n";
+}
+
 DeclID ASTReader::mapGlobalIDToModuleFileGlobalID(ModuleFile &M,
                                                   DeclID GlobalID) {
   if (GlobalID < NUM_PREDEF_DECL_IDS)
@@ -7672,6 +7946,19 @@ void ASTReader::PrintStats() {
                  NumVisibleDeclContextsRead, TotalVisibleDeclContexts,
                  ((float)NumVisibleDeclContextsRead/TotalVisibleDeclContexts
                   * 100));
+  if (NumRedeclChainsLoaded)
+    std::fprintf(stderr,
+                 "  %u redeclaration chains linked "
+                 "(%u links total, %u links in the longest chain)\n",
+                 NumRedeclChainsLoaded, NumRedeclLinksAttached,
+                 MaxRedeclChainLinks);
+  if (NumDeclReadsRequested)
+    std::fprintf(stderr,
+                 "  %u decl reads requested, %u cascaded "
+                 "(%.2fx read amplification)\n",
+                 NumDeclReadsRequested, NumCascadedDeclReads,
+                 (double)(NumDeclReadsRequested + NumCascadedDeclReads) /
+                     NumDeclReadsRequested);
   if (TotalNumMethodPoolEntries)
     std::fprintf(stderr, "  %u/%u method pool entries read (%f%%)\n",
                  NumMethodPoolEntriesRead, TotalNumMethodPoolEntries,
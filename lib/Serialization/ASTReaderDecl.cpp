@@ -4011,6 +4011,9 @@ void ASTReader::loadDeclUpdateRecords(PendingUpdateRecord &Record) {
 }
 
 void ASTReader::loadPendingDeclChain(Decl *FirstLocal, uint64_t LocalOffset) {
+  ++NumRedeclChainsLoaded;
+  unsigned NumLinks = 0;
+
   // Attach FirstLocal to the end of the decl chain.
   Decl *CanonDecl = FirstLocal->getCanonicalDecl();
   if (FirstLocal != CanonDecl) {
@@ -4018,10 +4021,14 @@ void ASTReader::loadPendingDeclChain(Decl *FirstLocal, uint64_t LocalOffset) {
     ASTDeclReader::attachPreviousDecl(
         *this, FirstLocal, PrevMostRecent ? PrevMostRecent : CanonDecl,
         CanonDecl);
+    ++NumLinks;
   }
 
   if (!LocalOffset) {
     ASTDeclReader::attachLatestDecl(CanonDecl, FirstLocal);
+    NumRedeclLinksAttached += NumLinks;
+    if (NumLinks > MaxRedeclChainLinks)
+      MaxRedeclChainLinks = NumLinks;
     return;
   }
 
@@ -4046,8 +4053,13 @@ void ASTReader::loadPendingDeclChain(Decl *FirstLocal, uint64_t LocalOffset) {
     auto *D = GetLocalDecl(*M, Record[N - I - 1]);
     ASTDeclReader::attachPreviousDecl(*this, D, MostRecent, CanonDecl);
     MostRecent = D;
+    ++NumLinks;
   }
   ASTDeclReader::attachLatestDecl(CanonDecl, MostRecent);
+
+  NumRedeclLinksAttached += NumLinks;
+  if (NumLinks > MaxRedeclChainLinks)
+    MaxRedeclChainLinks = NumLinks;
 }
 
 namespace {
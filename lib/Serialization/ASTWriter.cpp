@@ -31,6 +31,7 @@
 #include "clang/AST/LambdaCapture.h"
 #include "clang/AST/NestedNameSpecifier.h"
 #include "clang/AST/RawCommentList.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/TemplateName.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
@@ -98,6 +99,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/VersionTuple.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -1110,6 +1112,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(PPD_ENTITIES_OFFSETS);
   RECORD(VTABLE_USES);
   RECORD(PPD_SKIPPED_RANGES);
+  RECORD(RECORD_LAYOUTS);
   RECORD(REFERENCED_SELECTOR_POOL);
   RECORD(TU_UPDATE_LEXICAL);
   RECORD(SEMA_DECL_REFS);
@@ -1752,6 +1755,7 @@ struct InputFileEntry {
   bool IsTransient;
   bool BufferOverridden;
   bool IsTopLevelModuleMap;
+  uint64_t ContentHash;
 };
 
 } // namespace
@@ -1772,6 +1776,7 @@ void ASTWriter::WriteInputFiles(SourceManager &SourceMgr,
   IFAbbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 1)); // Overridden
   IFAbbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 1)); // Transient
   IFAbbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Fixed, 1)); // Module map
+  IFAbbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 16)); // Content hash
   IFAbbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob)); // File name
   unsigned IFAbbrevCode = Stream.EmitAbbrev(std::move(IFAbbrev));
 
@@ -1798,6 +1803,16 @@ void ASTWriter::WriteInputFiles(SourceManager &SourceMgr,
     Entry.BufferOverridden = Cache->BufferOverridden;
     Entry.IsTopLevelModuleMap = isModuleMap(File.getFileCharacteristic()) &&
                                 File.getIncludeLoc().isInvalid();
+
+    // Hash the contents so the reader can fall back to revalidating by
+    // content when the stored timestamp no longer matches.  The buffer is
+    // almost always already loaded here; if it is not, store zero rather
+    // than forcing I/O, which readers treat as "no hash recorded".
+    Entry.ContentHash = 0;
+    if (!Entry.BufferOverridden && !Entry.IsTransient)
+      if (const llvm::MemoryBuffer *Buffer = Cache->getRawBuffer())
+        Entry.ContentHash = llvm::xxHash64(Buffer->getBuffer());
+
     if (Cache->IsSystemFile)
       SortedFiles.push_back(Entry);
     else
@@ -1829,7 +1844,8 @@ void ASTWriter::WriteInputFiles(SourceManager &SourceMgr,
         (uint64_t)getTimestampForOutput(Entry.File),
         Entry.BufferOverridden,
         Entry.IsTransient,
-        Entry.IsTopLevelModuleMap};
+        Entry.IsTopLevelModuleMap,
+        Entry.ContentHash};
 
     EmitRecordWithPath(IFAbbrevCode, Record, Entry.File->getName());
   }
@@ -4409,6 +4425,125 @@ void ASTWriter::WriteMSPointersToMembersPragmaOptions(Sema &SemaRef) {
 }
 
 /// Write the state of 'pragma pack' at the end of the module.
+void ASTWriter::WriteRecordLayouts(ASTContext &Context) {
+  // Carry the record layouts computed while building this AST file along with
+  // it, so that importers can reuse them instead of re-running the layout
+  // builder. Only layouts whose record and referenced base classes were
+  // written out can be encoded; anything else is simply left for the importer
+  // to recompute.
+  // As in getDeclID, a declaration that comes from an AST file has a known,
+  // fixed ID; otherwise it must have been assigned one while writing. Zero
+  // means the declaration was not written and the layout cannot be encoded.
+  auto LookupDeclID = [&](const Decl *D) -> serialization::DeclID {
+    if (D->isFromASTFile())
+      return D->getGlobalID();
+    auto ID = DeclIDs.find(D);
+    return ID == DeclIDs.end() ? 0 : ID->second;
+  };
+
+  SmallVector<std::pair<serialization::DeclID, const RecordDecl *>, 64>
+      Layouts;
+  for (const auto &Entry : Context.ASTRecordLayouts) {
+    // Records from other AST files carry their own layout there.
+    if (Entry.first->isFromASTFile())
+      continue;
+    if (serialization::DeclID ID = LookupDeclID(Entry.first))
+      Layouts.push_back(std::make_pair(ID, Entry.first));
+  }
+  if (Layouts.empty())
+    return;
+
+  // Sort by declaration ID so the output does not depend on the layout
+  // cache's iteration order.
+  llvm::sort(Layouts.begin(), Layouts.end());
+
+  RecordData Record;
+  for (const auto &IDAndDecl : Layouts) {
+    const ASTRecordLayout &Layout =
+        *Context.ASTRecordLayouts.lookup(IDAndDecl.second);
+
+    RecordData Entry;
+    bool Encodable = true;
+    auto AddLayoutDeclRef = [&](const Decl *D) {
+      if (!D) {
+        Entry.push_back(0);
+        return;
+      }
+      if (serialization::DeclID ID = LookupDeclID(D))
+        Entry.push_back(ID);
+      else
+        Encodable = false;
+    };
+
+    Entry.push_back(IDAndDecl.first);
+    Entry.push_back(Layout.getSize().getQuantity());
+    Entry.push_back(Layout.getDataSize().getQuantity());
+    Entry.push_back(Layout.getAlignment().getQuantity());
+    Entry.push_back(Layout.getUnadjustedAlignment().getQuantity());
+    Entry.push_back(Layout.getRequiredAlignment().getQuantity());
+    Entry.push_back(Layout.getFieldCount());
+    for (unsigned I = 0, N = Layout.getFieldCount(); I != N; ++I)
+      Entry.push_back(Layout.getFieldOffset(I));
+
+    bool IsCXX = isa<CXXRecordDecl>(IDAndDecl.second);
+    Entry.push_back(IsCXX);
+    if (IsCXX) {
+      Entry.push_back(Layout.getNonVirtualSize().getQuantity());
+      Entry.push_back(Layout.getNonVirtualAlignment().getQuantity());
+      Entry.push_back(Layout.getSizeOfLargestEmptySubobject().getQuantity());
+      // The vbptr offset is -1 when absent; store the raw quantity.
+      Entry.push_back((uint64_t)Layout.getVBPtrOffset().getQuantity());
+      Entry.push_back(Layout.hasOwnVFPtr() |
+                      (Layout.hasExtendableVFPtr() << 1) |
+                      (Layout.endsWithZeroSizedObject() << 2) |
+                      (Layout.leadsWithZeroSizedBase() << 3) |
+                      (Layout.isPrimaryBaseVirtual() << 4));
+      AddLayoutDeclRef(Layout.getPrimaryBase());
+      AddLayoutDeclRef(Layout.getBaseSharingVBPtr());
+
+      // Sort the base maps by declaration ID, again for determinism.
+      SmallVector<std::pair<serialization::DeclID, const CXXRecordDecl *>, 8>
+          Bases;
+      for (const auto &Base : Layout.getBaseOffsetsMap()) {
+        if (serialization::DeclID ID = LookupDeclID(Base.first))
+          Bases.push_back(std::make_pair(ID, Base.first));
+        else
+          Encodable = false;
+      }
+      llvm::sort(Bases.begin(), Bases.end());
+      Entry.push_back(Bases.size());
+      for (const auto &Base : Bases) {
+        Entry.push_back(Base.first);
+        Entry.push_back(
+            Layout.getBaseClassOffset(Base.second).getQuantity());
+      }
+
+      Bases.clear();
+      for (const auto &VBase : Layout.getVBaseOffsetsMap()) {
+        if (serialization::DeclID ID = LookupDeclID(VBase.first))
+          Bases.push_back(std::make_pair(ID, VBase.first));
+        else
+          Encodable = false;
+      }
+      llvm::sort(Bases.begin(), Bases.end());
+      Entry.push_back(Bases.size());
+      for (const auto &VBase : Bases) {
+        const ASTRecordLayout::VBaseInfo &Info =
+            Layout.getVBaseOffsetsMap().lookup(VBase.second);
+        Entry.push_back(VBase.first);
+        Entry.push_back(Info.VBaseOffset.getQuantity());
+        Entry.push_back(Info.hasVtorDisp());
+      }
+    }
+
+    if (Encodable)
+      Record.append(Entry.begin(), Entry.end());
+  }
+
+  if (!Record.empty())
+    Stream.EmitRecord(RECORD_LAYOUTS, Record);
+}
+
 void ASTWriter::WritePackPragmaOptions(Sema &SemaRef) {
   // Don't serialize pragma pack state for modules, since it should only take
   // effect on a per-submodule basis.
@@ -5137,6 +5272,7 @@ ASTFileSignature ASTWriter::WriteASTCore(Sema &SemaRef, StringRef isysroot,
     WriteMSPointersToMembersPragmaOptions(SemaRef);
   }
   WritePackPragmaOptions(SemaRef);
+  WriteRecordLayouts(Context);
 
   // Some simple statistics
   RecordData::value_type Record[] = {
@@ -548,6 +548,7 @@ void ASTStmtWriter::VisitParenExpr(ParenExpr *E) {
   Record.AddSourceLocation(E->getLParen());
   Record.AddSourceLocation(E->getRParen());
   Record.AddStmt(E->getSubExpr());
+  AbbrevToUse = Writer.getExprParenAbbrev();
   Code = serialization::EXPR_PAREN;
 }
 
@@ -728,6 +729,12 @@ void ASTStmtWriter::VisitBinaryOperator(BinaryOperator *E) {
   Record.push_back(E->getOpcode()); // FIXME: stable encoding
   Record.AddSourceLocation(E->getOperatorLoc());
   Record.push_back(E->getFPFeatures().getInt());
+
+  // CompoundAssignOperator reuses this visitor and appends two more fields,
+  // so the abbreviation only fits a plain BinaryOperator.
+  if (E->getStmtClass() == Stmt::BinaryOperatorClass)
+    AbbrevToUse = Writer.getExprBinaryOperatorAbbrev();
+
   Code = serialization::EXPR_BINARY_OPERATOR;
 }
 
@@ -176,9 +176,13 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
       Buf = llvm::MemoryBuffer::getSTDIN();
     } else {
       // Get a buffer of the file and close the file descriptor when done.
+      // The AST file is consumed through a bitstream cursor and the on-disk
+      // hash tables are probed in place, so no null terminator is needed;
+      // this keeps the buffer memory-mapped even for page-aligned files.
       Buf = FileMgr.getBufferForFile(NewModule->File,
                                      /*IsVolatile=*/false,
-                                     /*ShouldClose=*/true);
+                                     /*ShouldClose=*/true,
+                                     /*RequiresNullTerminator=*/false);
     }
 
     if (!Buf) {
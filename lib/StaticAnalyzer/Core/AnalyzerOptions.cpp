@@ -427,6 +427,12 @@ unsigned AnalyzerOptions::getMaxNodesPerTopLevelFunction() {
   return MaxNodesPerTopLevelFunction.getValue();
 }
 
+unsigned AnalyzerOptions::getMaxMemoryMBPerTopLevelFunction() {
+  if (!MaxMemoryMBPerTopLevelFunction.hasValue())
+    MaxMemoryMBPerTopLevelFunction = getOptionAsInteger("max-memory-mb", 0);
+  return MaxMemoryMBPerTopLevelFunction.getValue();
+}
+
 bool AnalyzerOptions::shouldSynthesizeBodies() {
   return getBooleanOption("faux-bodies", true);
 }
@@ -503,6 +509,20 @@ bool AnalyzerOptions::naiveCTUEnabled() {
   return NaiveCTU.getValue();
 }
 
+StringRef AnalyzerOptions::getInlineSummariesInputFile() {
+  if (!InlineSummariesInputFile.hasValue())
+    InlineSummariesInputFile =
+        getOptionAsString("inline-summaries-input-file", "");
+  return InlineSummariesInputFile.getValue();
+}
+
+StringRef AnalyzerOptions::getInlineSummariesOutputFile() {
+  if (!InlineSummariesOutputFile.hasValue())
+    InlineSummariesOutputFile =
+        getOptionAsString("inline-summaries-output-file", "");
+  return InlineSummariesOutputFile.getValue();
+}
+
 StringRef AnalyzerOptions::getCTUIndexName() {
   if (!CTUIndexName.hasValue())
     CTUIndexName = getOptionAsString("ctu-index-name", "externalFnMap.txt");
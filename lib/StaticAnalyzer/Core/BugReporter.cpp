@@ -2861,6 +2861,15 @@ FindReportInEquivalenceClass(BugReportEquivClass& EQ,
   // stack for very long paths.
   BugReport *exampleReport = nullptr;
 
+  // Error nodes in the same equivalence class typically sit in overlapping
+  // regions of the graph, so remember per-node verdicts across reports:
+  // 'true' means a non-sink end-of-path node is reachable from the node,
+  // 'false' means the node's entire reachable region was explored and ends
+  // only in sinks.  Without this the per-report traversals below re-explore
+  // the same sink regions once per report, which is quadratic when a noisy
+  // checker piles duplicate reports onto one class.
+  llvm::DenseMap<const ExplodedNode *, bool> ReachesNonSinkEnd;
+
   for (; I != E; ++I) {
     const ExplodedNode *errorNode = I->getErrorNode();
 
@@ -2885,6 +2894,18 @@ FindReportInEquivalenceClass(BugReportEquivClass& EQ,
     if (isInevitablySinking(errorNode))
       continue;
 
+    // Did a previous report in this class already settle this node?
+    llvm::DenseMap<const ExplodedNode *, bool>::iterator Known =
+        ReachesNonSinkEnd.find(errorNode);
+    if (Known != ReachesNonSinkEnd.end()) {
+      if (Known->second) {
+        bugReports.push_back(&*I);
+        if (!exampleReport)
+          exampleReport = &*I;
+      }
+      continue;
+    }
+
     // At this point we know that 'N' is not a sink and it has at least one
     // successor.  Use a DFS worklist to find a non-sink end-of-path node.
     using WLItem = FRIEC_WLItem;
@@ -2895,6 +2916,7 @@ FindReportInEquivalenceClass(BugReportEquivClass& EQ,
     DFSWorkList WL;
     WL.push_back(errorNode);
     Visited[errorNode] = 1;
+    bool FoundNonSinkEnd = false;
 
     while (!WL.empty()) {
       WLItem &WI = WL.back();
@@ -2902,14 +2924,19 @@ FindReportInEquivalenceClass(BugReportEquivClass& EQ,
 
       for (; WI.I != WI.E; ++WI.I) {
         const ExplodedNode *Succ = *WI.I;
+        // Reuse verdicts from earlier reports in this equivalence class.
+        Known = ReachesNonSinkEnd.find(Succ);
+        if (Known != ReachesNonSinkEnd.end()) {
+          if (!Known->second)
+            continue;
+          FoundNonSinkEnd = true;
+          break;
+        }
         // End-of-path node?
         if (Succ->succ_empty()) {
           // If we found an end-of-path node that is not a sink.
           if (!Succ->isSink()) {
-            bugReports.push_back(&*I);
-            if (!exampleReport)
-              exampleReport = &*I;
-            WL.clear();
+            FoundNonSinkEnd = true;
             break;
           }
           // Found a sink?  Continue on to the next successor.
@@ -2925,11 +2952,30 @@ FindReportInEquivalenceClass(BugReportEquivClass& EQ,
         }
       }
 
+      if (FoundNonSinkEnd) {
+        // Every node on the DFS stack lies on a path to the end-of-path node
+        // we just found; let later reports shortcut through them.
+        for (const WLItem &StackItem : WL)
+          ReachesNonSinkEnd[StackItem.N] = true;
+        break;
+      }
+
       // The worklist may have been cleared at this point.  First
       // check if it is empty before checking the last item.
       if (!WL.empty() && &WL.back() == &WI)
         WL.pop_back();
     }
+
+    if (FoundNonSinkEnd) {
+      bugReports.push_back(&*I);
+      if (!exampleReport)
+        exampleReport = &*I;
+    } else {
+      // The traversal above was exhaustive, so everything it visited is now
+      // known to end only in sinks.
+      for (const auto &V : Visited)
+        ReachesNonSinkEnd[V.first] = false;
+    }
   }
 
   // ExampleReport will be NULL if all the nodes in the equivalence class
@@ -16,15 +16,18 @@
 #include "clang/AST/Stmt.h"
 #include "clang/Analysis/ProgramPoint.h"
 #include "clang/Basic/LLVM.h"
+#include "clang/StaticAnalyzer/Core/AnalyzerOptions.h"
 #include "clang/StaticAnalyzer/Core/Checker.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/CallEvent.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/CheckerContext.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/CoreEngine.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExprEngine.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/SVals.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Timer.h"
 #include <cassert>
 #include <vector>
 
@@ -49,6 +52,29 @@ bool CheckerManager::hasPathSensitiveCheckers() const {
          !EvalCallCheckers.empty();
 }
 
+llvm::Timer *CheckerManager::getCheckerTimer(CheckerBase *Checker) {
+  if (!AOptions.CheckerProfiling)
+    return nullptr;
+
+  if (!CheckerTimerGroup)
+    CheckerTimerGroup = llvm::make_unique<llvm::TimerGroup>(
+        "analyzerCheckers", "Static analyzer checkers");
+
+  std::unique_ptr<llvm::Timer> &T = CheckerTimers[Checker];
+  if (!T) {
+    StringRef Name =
+        Checker ? Checker->getCheckName().getName() : "<unknown checker>";
+    T = llvm::make_unique<llvm::Timer>(Name, Name, *CheckerTimerGroup);
+  }
+
+  // A checker callback can transitively trigger another callback of the same
+  // checker (e.g. an evalCall implementation forcing a bind). Attribute such
+  // nested work to the region that is already running.
+  if (T->isRunning())
+    return nullptr;
+  return T.get();
+}
+
 void CheckerManager::finishedCheckerRegistration() {
 #ifndef NDEBUG
   // Make sure that for every event that has listeners, there is at least
@@ -115,6 +141,8 @@ static void expandGraphWithCheckers(CHECK_CTX checkCtx,
   ExplodedNodeSet Tmp1, Tmp2;
   const ExplodedNodeSet *PrevSet = &Src;
 
+  CheckerManager &Mgr = checkCtx.Eng.getCheckerManager();
+
   for (; I != E; ++I) {
     ExplodedNodeSet *CurrSet = nullptr;
     if (I+1 == E)
@@ -124,6 +152,10 @@ static void expandGraphWithCheckers(CHECK_CTX checkCtx,
       CurrSet->clear();
     }
 
+    // Attribute the time spent on this checker's callback to it; this is a
+    // no-op unless -analyzer-checker-profile is on.
+    llvm::TimeRegion TR(Mgr.getCheckerTimer(I->Checker));
+
     NodeBuilder B(*PrevSet, *CurrSet, BldrCtx);
     for (const auto &NI : *PrevSet)
       checkCtx.runChecker(*I, B, NI);
@@ -658,6 +690,7 @@ void CheckerManager::runCheckersForEvalCall(ExplodedNodeSet &Dst,
       { // CheckerContext generates transitions(populates checkDest) on
         // destruction, so introduce the scope to make sure it gets properly
         // populated.
+        llvm::TimeRegion TR(getCheckerTimer(EvalCallChecker.Checker));
         CheckerContext C(B, Eng, Pred, L);
         evaluated = EvalCallChecker(CE, C);
       }
@@ -22,6 +22,7 @@
 #include "clang/Analysis/ProgramPoint.h"
 #include "clang/Basic/LLVM.h"
 #include "clang/StaticAnalyzer/Core/AnalyzerOptions.h"
+#include "clang/StaticAnalyzer/Core/PathSensitive/AnalysisManager.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/BlockCounter.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExplodedGraph.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/FunctionSummary.h"
@@ -46,6 +47,8 @@ STATISTIC(NumSteps,
             "The # of steps executed.");
 STATISTIC(NumReachedMaxSteps,
             "The # of times we reached the max number of steps.");
+STATISTIC(NumReachedMaxMemory,
+            "The # of times we reached the memory budget.");
 STATISTIC(NumPathsExplored,
             "The # of paths explored by the analyzer.");
 
@@ -127,6 +130,15 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
   if(!UnlimitedSteps)
     G.reserve(std::min(Steps,PreReservationCap));
 
+  // The memory budget, if any, covers the graph's allocator, which nodes,
+  // states, environments and store bindings all share.  Checking it walks
+  // the allocator's slab list, so only do so periodically.
+  const uint64_t MemoryBudget =
+      uint64_t(SubEng.getAnalysisManager()
+                   .options.getMaxMemoryMBPerTopLevelFunction()) << 20;
+  const unsigned MemoryCheckInterval = 1024;
+  unsigned StepsUntilMemoryCheck = MemoryCheckInterval;
+
   while (WList->hasWork()) {
     if (!UnlimitedSteps) {
       if (Steps == 0) {
@@ -136,6 +148,14 @@ bool CoreEngine::ExecuteWorkList(const LocationContext *L, unsigned Steps,
       --Steps;
     }
 
+    if (MemoryBudget && --StepsUntilMemoryCheck == 0) {
+      StepsUntilMemoryCheck = MemoryCheckInterval;
+      if (G.getAllocator().getTotalMemory() >= MemoryBudget) {
+        NumReachedMaxMemory++;
+        break;
+      }
+    }
+
     NumSteps++;
 
     const WorkListUnit& WU = WList->dequeue();
@@ -66,6 +66,12 @@ class HTMLDiagnostics : public PathDiagnosticConsumer {
   AnalyzerOptions &AnalyzerOpts;
   const bool SupportsCrossFileDiagnostics;
 
+  // Multiple reports frequently refer to the same file; share the relexed
+  // highlight edits across all of them so each file is lexed and
+  // re-preprocessed at most once per run.
+  html::RelexRewriteCacheRef RewriteCache =
+      html::instantiateRelexRewriteCache();
+
 public:
   HTMLDiagnostics(AnalyzerOptions &AnalyzerOpts,
                   const std::string& prefix,
@@ -643,8 +649,8 @@ void HTMLDiagnostics::RewriteFile(Rewriter &R,
   // We might not have a preprocessor if we come from a deserialized AST file,
   // for example.
 
-  html::SyntaxHighlight(R, FID, PP);
-  html::HighlightMacros(R, FID, PP);
+  html::SyntaxHighlight(R, FID, PP, RewriteCache);
+  html::HighlightMacros(R, FID, PP, RewriteCache);
 }
 
 void HTMLDiagnostics::HandlePiece(Rewriter& R, FileID BugFileID,
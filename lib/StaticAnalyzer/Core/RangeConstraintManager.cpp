@@ -65,6 +65,16 @@ const llvm::APSInt &RangeSet::getMinValue() const {
   return ranges.begin()->From();
 }
 
+const llvm::APSInt &RangeSet::getMaxValue() const {
+  assert(!isEmpty());
+  // The ranges are sorted, so the maximum is the upper bound of the last one.
+  // ImmutableSet does not offer reverse iteration, but these sets are tiny.
+  PrimRangeSet::iterator i = begin(), e = end(), last = i;
+  for (; i != e; ++i)
+    last = i;
+  return last->To();
+}
+
 bool RangeSet::pin(llvm::APSInt &Lower, llvm::APSInt &Upper) const {
   // This function has nine cases, the cartesian product of range-testing
   // both the upper and lower bounds against the symbol's type.
@@ -158,6 +168,16 @@ RangeSet RangeSet::Intersect(BasicValueFactory &BV, Factory &F,
   if (!pin(Lower, Upper))
     return F.getEmptySet();
 
+  // Fast path: if the set already lies entirely inside the (non-wrapping)
+  // intersection range, the intersection is the set itself.  This is the
+  // common case when a symbol is re-checked against bounds it is already
+  // known to satisfy, and it avoids rebuilding an identical AVL tree through
+  // the factory.  pin() has adjusted Lower and Upper to the symbol's type,
+  // so the comparisons below are between like-typed APSInts.
+  if (Lower <= Upper && !isEmpty() && Lower <= getMinValue() &&
+      getMaxValue() <= Upper)
+    return *this;
+
   PrimRangeSet newRanges = F.getEmptySet();
 
   PrimRangeSet::iterator i = begin(), e = end();
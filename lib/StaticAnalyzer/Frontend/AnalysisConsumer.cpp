@@ -24,6 +24,8 @@
 #include "clang/Basic/SourceManager.h"
 #include "clang/CrossTU/CrossTranslationUnit.h"
 #include "clang/Frontend/CompilerInstance.h"
+#include "clang/Index/USRGeneration.h"
+#include "clang/Lex/Lexer.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/StaticAnalyzer/Checkers/LocalCheckers.h"
 #include "clang/StaticAnalyzer/Core/AnalyzerOptions.h"
@@ -34,13 +36,21 @@
 #include "clang/StaticAnalyzer/Core/PathSensitive/AnalysisManager.h"
 #include "clang/StaticAnalyzer/Core/PathSensitive/ExprEngine.h"
 #include "clang/StaticAnalyzer/Frontend/CheckerRegistration.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/LineIterator.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <memory>
 #include <queue>
 #include <utility>
@@ -146,6 +156,11 @@ public:
 // AnalysisConsumer declaration.
 //===----------------------------------------------------------------------===//
 
+// Defined below, next to the other call-graph walk helpers; declared here
+// so the inline summary-store members of AnalysisConsumer can use it.
+static bool getInlineSummaryKey(const Decl *D, SmallVectorImpl<char> &USR,
+                                uint64_t &BodyHash);
+
 namespace {
 
 class AnalysisConsumer : public AnalysisASTConsumer,
@@ -197,6 +212,23 @@ public:
   /// translation unit.
   FunctionSummariesTy FunctionSummaries;
 
+  /// Inlining verdicts preloaded from a previous run, keyed by USR; the
+  /// value pairs the callee's body hash with its may-inline verdict.
+  llvm::StringMap<std::pair<uint64_t, bool>> ImportedInlineVerdicts;
+
+  /// An inclusive line range within a named file, as given to
+  /// -analyze-regions.
+  struct RegionOfInterest {
+    std::string File;
+    unsigned BeginLine;
+    unsigned EndLine;
+  };
+
+  /// When non-empty, analysis is restricted to functions intersecting one
+  /// of these regions, plus (with inlining enabled) their transitive
+  /// callers.
+  std::vector<RegionOfInterest> RegionsOfInterest;
+
   AnalysisConsumer(CompilerInstance &CI, const std::string &outdir,
                    AnalyzerOptionsRef opts, ArrayRef<std::string> plugins,
                    CodeInjector *injector)
@@ -204,6 +236,8 @@ public:
         PP(CI.getPreprocessor()), OutDir(outdir), Opts(std::move(opts)),
         Plugins(plugins), Injector(injector), CTU(CI) {
     DigestAnalyzerOptions();
+    parseRegionsOfInterest();
+    loadInlineSummaries();
     if (Opts->PrintStats || Opts->shouldSerializeStats()) {
       AnalyzerTimers = llvm::make_unique<llvm::TimerGroup>(
           "analyzer", "Analyzer timers");
@@ -219,6 +253,100 @@ public:
     }
   }
 
+  /// Parse the -analyze-regions specification, a comma separated list of
+  /// <file>:<line>[-<line>] entries.  Malformed entries are dropped.
+  void parseRegionsOfInterest() {
+    SmallVector<StringRef, 8> Entries;
+    StringRef(Opts->AnalyzeRegionsOfInterest)
+        .split(Entries, ',', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+    for (StringRef Entry : Entries) {
+      // Split on the last ':' so that paths containing colons survive.
+      size_t Colon = Entry.rfind(':');
+      if (Colon == StringRef::npos || Colon == 0)
+        continue;
+      StringRef Begin, End;
+      std::tie(Begin, End) = Entry.substr(Colon + 1).split('-');
+      RegionOfInterest R;
+      R.File = Entry.substr(0, Colon);
+      if (Begin.getAsInteger(10, R.BeginLine))
+        continue;
+      R.EndLine = R.BeginLine;
+      if (!End.empty() && End.getAsInteger(10, R.EndLine))
+        continue;
+      if (R.EndLine < R.BeginLine)
+        continue;
+      RegionsOfInterest.push_back(std::move(R));
+    }
+  }
+
+  /// Returns true if \p D's body (or the declaration itself, when it has
+  /// no body) overlaps one of the regions of interest.  The region file is
+  /// matched against the presumed file name, either exactly or as a
+  /// trailing path suffix, so diff-relative paths work.
+  bool declIntersectsRegions(const Decl *D) const {
+    const SourceManager &SM = Ctx->getSourceManager();
+    const Stmt *Body = D->getBody();
+    SourceRange SR = Body ? Body->getSourceRange() : D->getSourceRange();
+    PresumedLoc Begin = SM.getPresumedLoc(SM.getExpansionLoc(SR.getBegin()));
+    PresumedLoc End = SM.getPresumedLoc(SM.getExpansionLoc(SR.getEnd()));
+    if (Begin.isInvalid() || End.isInvalid())
+      return true; // Conservatively analyze what we cannot place.
+
+    StringRef File = Begin.getFilename();
+    for (const RegionOfInterest &R : RegionsOfInterest) {
+      if (File != R.File &&
+          !(File.size() > R.File.size() && File.endswith(R.File) &&
+            File[File.size() - R.File.size() - 1] == '/'))
+        continue;
+      if (R.BeginLine <= End.getLine() && Begin.getLine() <= R.EndLine)
+        return true;
+    }
+    return false;
+  }
+
+  /// Preload inlining verdicts recorded by a previous run, if requested
+  /// via the inline-summaries-input-file analyzer config.
+  void loadInlineSummaries() {
+    StringRef Path = Opts->getInlineSummariesInputFile();
+    if (Path.empty())
+      return;
+    auto Buffer = llvm::MemoryBuffer::getFile(Path);
+    if (!Buffer)
+      return;
+    // Each line is "<body-hash> <verdict> <USR>".
+    for (llvm::line_iterator LI(**Buffer, /*SkipBlanks=*/true);
+         !LI.is_at_eof(); ++LI) {
+      SmallVector<StringRef, 3> Fields;
+      LI->split(Fields, ' ');
+      uint64_t Hash;
+      if (Fields.size() != 3 || Fields[0].getAsInteger(16, Hash))
+        continue;
+      ImportedInlineVerdicts[Fields[2]] =
+          std::make_pair(Hash, Fields[1] == "1");
+    }
+  }
+
+  /// Persist this run's inlining verdicts, if requested via the
+  /// inline-summaries-output-file analyzer config.
+  void writeInlineSummaries() {
+    StringRef Path = Opts->getInlineSummariesOutputFile();
+    if (Path.empty())
+      return;
+    std::error_code EC;
+    llvm::raw_fd_ostream OS(Path, EC, llvm::sys::fs::F_Text);
+    if (EC)
+      return;
+    FunctionSummaries.forEachInlineVerdict(
+        [&OS](const Decl *D, bool MayInline) {
+          SmallString<128> USR;
+          uint64_t BodyHash;
+          if (!getInlineSummaryKey(D, USR, BodyHash))
+            return;
+          OS << llvm::format_hex_no_prefix(BodyHash, 16) << ' '
+             << (MayInline ? '1' : '0') << ' ' << USR << '\n';
+        });
+  }
+
   void DigestAnalyzerOptions() {
     if (Opts->AnalysisDiagOpt != PD_NONE) {
       // Create the PathDiagnosticConsumer.
@@ -476,6 +604,33 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     CG.addToCallGraph(LocalTUDecls[i]);
   }
 
+  // When regions of interest are given, the interesting entry points are
+  // the functions whose bodies overlap a region together with their
+  // transitive callers: analyzing a caller as top level is what exercises
+  // a changed callee in its real calling contexts.
+  llvm::DenseSet<CallGraphNode *> RegionNodes;
+  if (!RegionsOfInterest.empty()) {
+    llvm::DenseMap<CallGraphNode *, SmallVector<CallGraphNode *, 4>> Callers;
+    SmallVector<CallGraphNode *, 16> Worklist;
+    for (auto &Entry : CG) {
+      CallGraphNode *N = Entry.second.get();
+      for (CallGraphNode *Callee : *N)
+        Callers[Callee].push_back(N);
+      if (N->getDecl() && declIntersectsRegions(N->getDecl()) &&
+          RegionNodes.insert(N).second)
+        Worklist.push_back(N);
+    }
+    while (!Worklist.empty()) {
+      CallGraphNode *N = Worklist.pop_back_val();
+      auto It = Callers.find(N);
+      if (It == Callers.end())
+        continue;
+      for (CallGraphNode *Caller : It->second)
+        if (RegionNodes.insert(Caller).second)
+          Worklist.push_back(Caller);
+    }
+  }
+
   // Walk over all of the call graph nodes in topological order, so that we
   // analyze parents before the children. Skip the functions inlined into
   // the previously processed functions. Use external Visited set to identify
@@ -496,6 +651,11 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
     if (!D)
       continue;
 
+    // Skip functions that neither overlap a region of interest nor reach
+    // one through their callees.
+    if (!RegionsOfInterest.empty() && !RegionNodes.count(N))
+      continue;
+
     // Skip the functions which have been processed already or previously
     // inlined.
     if (shouldSkipFunction(D, Visited, VisitedAsTopLevel))
@@ -517,6 +677,28 @@ void AnalysisConsumer::HandleDeclsCallGraph(const unsigned LocalTUDeclsSize) {
   }
 }
 
+/// Compute the stable identity used by the persisted inline-summary store
+/// for \p D: its USR plus a hash of its body's source text.  Returns false
+/// for declarations that cannot be keyed (no body, invalid source range, or
+/// USR generation failure).
+static bool getInlineSummaryKey(const Decl *D, SmallVectorImpl<char> &USR,
+                                uint64_t &BodyHash) {
+  const Stmt *Body = D->getBody();
+  if (!Body)
+    return false;
+  if (index::generateUSRForDecl(D, USR))
+    return false;
+  const ASTContext &Ctx = D->getASTContext();
+  bool Invalid = false;
+  StringRef Text = Lexer::getSourceText(
+      CharSourceRange::getTokenRange(Body->getSourceRange()),
+      Ctx.getSourceManager(), Ctx.getLangOpts(), &Invalid);
+  if (Invalid || Text.empty())
+    return false;
+  BodyHash = llvm::xxHash64(Text);
+  return true;
+}
+
 static bool isBisonFile(ASTContext &C) {
   const SourceManager &SM = C.getSourceManager();
   FileID FID = SM.getMainFileID();
@@ -527,6 +709,22 @@ static bool isBisonFile(ASTContext &C) {
 }
 
 void AnalysisConsumer::runAnalysisOnTranslationUnit(ASTContext &C) {
+  // Replay inlining verdicts from a previous run for callees whose USR and
+  // body text still match; the summary map caches each replayed verdict.
+  if (!ImportedInlineVerdicts.empty())
+    FunctionSummaries.setExternalInlineVerdict(
+        [this](const Decl *D) -> Optional<bool> {
+          SmallString<128> USR;
+          uint64_t BodyHash;
+          if (!getInlineSummaryKey(D, USR, BodyHash))
+            return None;
+          auto It = ImportedInlineVerdicts.find(USR);
+          if (It == ImportedInlineVerdicts.end() ||
+              It->second.first != BodyHash)
+            return None;
+          return It->second.second;
+        });
+
   BugReporter BR(*Mgr);
   TranslationUnitDecl *TU = C.getTranslationUnitDecl();
   checkerMgr->runCheckersOnASTDecl(TU, *Mgr, BR);
@@ -596,6 +794,8 @@ void AnalysisConsumer::HandleTranslationUnit(ASTContext &C) {
       (FunctionSummaries.getTotalNumVisitedBasicBlocks() * 100) /
         NumBlocksInAnalyzedFunctions;
 
+  writeInlineSummaries();
+
   // Explicitly destroy the PathDiagnosticConsumer.  This will flush its output.
   // FIXME: This should be replaced with something that doesn't rely on
   // side-effects in PathDiagnosticConsumer's destructor. This is required when
@@ -669,6 +869,16 @@ AnalysisConsumer::getModeForDecl(Decl *D, AnalysisMode Mode) {
       getFunctionName(D) != Opts->AnalyzeSpecificFunction)
     return AM_None;
 
+  if (!RegionsOfInterest.empty() && !declIntersectsRegions(D)) {
+    // Syntax checks inspect only the function itself, so they are pointless
+    // outside the regions.  Path-sensitive entry points are filtered against
+    // transitive callees in HandleDeclsCallGraph when inlining is enabled;
+    // without a call graph, fall back to requiring a direct overlap.
+    Mode &= ~AM_Syntax;
+    if (!Mgr->shouldInlineCall())
+      Mode &= ~AM_Path;
+  }
+
   // Unless -analyze-all is specified, treat decls differently depending on
   // where they came from:
   // - Main source file: run both path-sensitive and non-path-sensitive checks.
@@ -238,6 +238,7 @@ JSONCompilationDatabase::getCompileCommands(StringRef FilePath) const {
 std::vector<std::string>
 JSONCompilationDatabase::getAllFiles() const {
   std::vector<std::string> Result;
+  Result.reserve(IndexByFile.size());
   for (const auto &CommandRef : IndexByFile)
     Result.push_back(CommandRef.first().str());
   return Result;
@@ -252,11 +253,12 @@ JSONCompilationDatabase::getAllCompileCommands() const {
 
 static std::vector<std::string>
 nodeToCommandLine(JSONCommandLineSyntax Syntax,
-                  const std::vector<llvm::yaml::ScalarNode *> &Nodes) {
+                  ArrayRef<llvm::yaml::ScalarNode *> Nodes) {
   SmallString<1024> Storage;
   if (Nodes.size() == 1)
     return unescapeCommandLine(Syntax, Nodes[0]->getValue(Storage));
   std::vector<std::string> Arguments;
+  Arguments.reserve(Nodes.size());
   for (const auto *Node : Nodes)
     Arguments.push_back(Node->getValue(Storage));
   return Arguments;
@@ -265,6 +267,7 @@ nodeToCommandLine(JSONCommandLineSyntax Syntax,
 void JSONCompilationDatabase::getCommands(
     ArrayRef<CompileCommandRef> CommandsRef,
     std::vector<CompileCommand> &Commands) const {
+  Commands.reserve(Commands.size() + CommandsRef.size());
   for (const auto &CommandRef : CommandsRef) {
     SmallString<8> DirectoryStorage;
     SmallString<32> FilenameStorage;
@@ -301,7 +304,7 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
       return false;
     }
     llvm::yaml::ScalarNode *Directory = nullptr;
-    llvm::Optional<std::vector<llvm::yaml::ScalarNode *>> Command;
+    llvm::Optional<CommandLineRef> Command;
     llvm::yaml::ScalarNode *File = nullptr;
     llvm::yaml::ScalarNode *Output = nullptr;
     for (auto& NextKeyValue : *Object) {
@@ -329,7 +332,7 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
       if (KeyValue == "directory") {
         Directory = ValueString;
       } else if (KeyValue == "arguments") {
-        Command = std::vector<llvm::yaml::ScalarNode *>();
+        Command = CommandLineRef();
         for (auto &Argument : *SequenceString) {
           auto *Scalar = dyn_cast<llvm::yaml::ScalarNode>(&Argument);
           if (!Scalar) {
@@ -340,7 +343,7 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
         }
       } else if (KeyValue == "command") {
         if (!Command)
-          Command = std::vector<llvm::yaml::ScalarNode *>(1, ValueString);
+          Command = CommandLineRef(1, ValueString);
       } else if (KeyValue == "file") {
         File = ValueString;
       } else if (KeyValue == "output") {
@@ -375,9 +378,9 @@ bool JSONCompilationDatabase::parse(std::string &ErrorMessage) {
     } else {
       llvm::sys::path::native(FileName, NativeFilePath);
     }
-    auto Cmd = CompileCommandRef(Directory, File, *Command, Output);
+    auto Cmd = CompileCommandRef(Directory, File, std::move(*Command), Output);
     IndexByFile[NativeFilePath].push_back(Cmd);
-    AllCommands.push_back(Cmd);
+    AllCommands.push_back(std::move(Cmd));
     MatchTrie.insert(NativeFilePath);
   }
   return true;
@@ -0,0 +1,25 @@
+// RUN: %clang_analyze_cc1 -analyzer-checker=core.DivideZero -analyze-regions=%s:100-104 -verify %s
+// RUN: %clang_analyze_cc1 -analyzer-checker=core.DivideZero -analyze-regions=%s:300-304 -verify %s
+
+// Only functions intersecting the region (or reaching it through calls,
+// when inlining is enabled) are analyzed; the identical bug outside the
+// region must stay silent.
+
+#line 100
+int inside(int x) {
+  if (x == 0)
+    return 1 / x; // expected-warning {{Division by zero}}
+  return 0;
+}
+
+#line 200
+int outside(int x) {
+  if (x == 0)
+    return 1 / x; // no-warning
+  return 0;
+}
+
+#line 300
+int caller(void) {
+  return inside(0);
+}
@@ -0,0 +1,8 @@
+/* Same token stream as token-hash.c, different formatting. */
+#define VALUE 42
+int f(int x) {
+  return x + VALUE; /* trailing comment */
+}
+#ifdef TOKEN_HASH_EXTRA
+int g(void);
+#endif
@@ -0,0 +1,39 @@
+// RUN: %clang_cc1 -std=c++11 -emit-decl-hashes %s -o %t.self
+// RUN: %clang_cc1 -std=c++11 -emit-decl-hashes %s -o %t.again
+// RUN: diff %t.self %t.again
+//
+// An edit that only touches comments must not change any hash.
+// RUN: %clang_cc1 -std=c++11 -emit-decl-hashes -DDECL_HASHES_COMMENT %s -o %t.comment
+// RUN: diff %t.self %t.comment
+//
+// Changing an inline body must change that decl's hash.
+// RUN: %clang_cc1 -std=c++11 -emit-decl-hashes -DDECL_HASHES_BODY %s -o %t.body
+// RUN: not diff %t.self %t.body
+//
+// Each hashable decl appears once, with its qualified name.
+// RUN: FileCheck %s < %t.self
+
+namespace units {
+struct Meters {
+  double Value;
+  double get() const { return Value; }
+};
+
+#ifdef DECL_HASHES_COMMENT
+// A comment that must not affect the manifest.
+#endif
+
+inline double scale(Meters M) {
+#ifdef DECL_HASHES_BODY
+  return M.Value * 2;
+#else
+  return M.Value;
+#endif
+}
+} // namespace units
+
+enum class Unit { Meter, Second };
+
+// CHECK: {{^[0-9a-f]+ }}units::Meters
+// CHECK: {{^[0-9a-f]+ }}units::scale
+// CHECK: {{^[0-9a-f]+ }}Unit
@@ -0,0 +1,20 @@
+// RUN: %clang_cc1 -token-hash %s > %t.self
+// RUN: %clang_cc1 -token-hash %s > %t.again
+// RUN: diff %t.self %t.again
+//
+// A copy that differs only in comments, whitespace, and line placement must
+// produce the identical hash.
+// RUN: %clang_cc1 -token-hash %S/Inputs/token-hash-reformatted.c > %t.reformatted
+// RUN: diff %t.self %t.reformatted
+//
+// Changing a token must change the hash.
+// RUN: %clang_cc1 -token-hash -DTOKEN_HASH_EXTRA %s > %t.extra
+// RUN: not diff %t.self %t.extra
+
+#define VALUE 42
+
+int f(int x) { return x + VALUE; }
+
+#ifdef TOKEN_HASH_EXTRA
+int g(void);
+#endif
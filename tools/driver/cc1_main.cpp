@@ -17,6 +17,7 @@
 #include "clang/CodeGen/ObjectFilePCHContainerOperations.h"
 #include "clang/Config/config.h"
 #include "clang/Basic/Stack.h"
+#include "clang/Basic/TimeTrace.h"
 #include "clang/Driver/DriverDiagnostic.h"
 #include "clang/Driver/Options.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -26,6 +27,7 @@
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Frontend/Utils.h"
 #include "clang/FrontendTool/Utils.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/LinkAllPasses.h"
@@ -34,6 +36,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Signals.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/Timer.h"
@@ -215,7 +218,31 @@ int cc1_main(ArrayRef<const char *> Argv, const char *Argv0, void *MainAddr) {
     return 1;
 
   // Execute the frontend actions.
-  Success = ExecuteCompilerInvocation(Clang.get());
+  {
+    if (Clang->getFrontendOpts().TimeTrace)
+      clang::timeTraceProfilerInitialize();
+    clang::TimeTraceScope TimeScope("ExecuteCompilerInvocation", StringRef(""));
+    Success = ExecuteCompilerInvocation(Clang.get());
+  }
+
+  if (clang::timeTraceProfilerEnabled()) {
+    // Write the trace next to the main output file so each TU in a build
+    // gets its own profile.
+    SmallString<128> Path(Clang->getFrontendOpts().OutputFile);
+    llvm::sys::path::replace_extension(Path, "json");
+    if (std::unique_ptr<llvm::raw_pwrite_stream> ProfilerOutput =
+            Clang->createOutputFile(Path.str(), /*Binary=*/false,
+                                    /*RemoveFileOnSignal=*/false, "",
+                                    /*Extension=*/"json",
+                                    /*UseTemporary=*/false)) {
+      clang::timeTraceProfilerWrite(*ProfilerOutput);
+      // The profiler object is still around in -disable-free mode; that is
+      // harmless, but clean it up when we do free.
+      if (!Clang->getFrontendOpts().DisableFree)
+        clang::timeTraceProfilerCleanup();
+      Clang->clearOutputFiles(false);
+    }
+  }
 
   // If any timers were active but haven't been destroyed yet, print their
   // results now.  This happens in -disable-free mode.
@@ -4405,6 +4405,54 @@ unsigned clang_visitChildrenWithBlock(CXCursor parent,
   return clang_visitChildren(parent, visitWithBlock, block);
 }
 
+namespace {
+struct CollectChildrenData {
+  SmallVector<CXCursor, 128> Cursors;
+  const enum CXCursorKind *Kinds;
+  unsigned NumKinds;
+  bool Recurse;
+};
+} // end anonymous namespace
+
+static enum CXChildVisitResult collectChildrenVisitor(CXCursor cursor,
+                                                      CXCursor parent,
+                                                      CXClientData client_data) {
+  CollectChildrenData *data = static_cast<CollectChildrenData *>(client_data);
+  bool wanted = data->NumKinds == 0;
+  for (unsigned i = 0; !wanted && i != data->NumKinds; ++i)
+    wanted = data->Kinds[i] == cursor.kind;
+  if (wanted)
+    data->Cursors.push_back(cursor);
+  return data->Recurse ? CXChildVisit_Recurse : CXChildVisit_Continue;
+}
+
+CXCursorList *clang_collectChildren(CXCursor parent,
+                                    const enum CXCursorKind *kinds,
+                                    unsigned num_kinds, unsigned recurse) {
+  CXCursorList *list = new CXCursorList;
+  list->count = 0;
+  list->cursors = nullptr;
+
+  CollectChildrenData data;
+  data.Kinds = kinds;
+  data.NumKinds = kinds ? num_kinds : 0;
+  data.Recurse = recurse != 0;
+  clang_visitChildren(parent, collectChildrenVisitor, &data);
+
+  list->count = data.Cursors.size();
+  list->cursors = new CXCursor[list->count];
+  for (unsigned i = 0, e = list->count; i != e; ++i)
+    list->cursors[i] = data.Cursors[i];
+  return list;
+}
+
+void clang_disposeCursorList(CXCursorList *cursors) {
+  if (cursors) {
+    delete[] cursors->cursors;
+    delete cursors;
+  }
+}
+
 static CXString getDeclSpelling(const Decl *D) {
   if (!D)
     return cxstring::createEmpty();
@@ -6635,6 +6683,47 @@ CXSourceRange clang_getTokenExtent(CXTranslationUnit TU, CXToken CXTok) {
                         SourceLocation::getFromRawEncoding(CXTok.int_data[1]));
 }
 
+void clang_getTokenRecords(CXTranslationUnit TU, const CXToken *Tokens,
+                           unsigned NumTokens, CXTokenRecord *Records) {
+  if (isNotUsableTU(TU)) {
+    LOG_BAD_TU(TU);
+    return;
+  }
+
+  ASTUnit *CXXUnit = cxtu::getASTUnit(TU);
+  if (!CXXUnit || !Tokens || !Records)
+    return;
+
+  SourceManager &SM = CXXUnit->getSourceManager();
+
+  // Tokens come from the raw lexer in position order, so resolve the
+  // (file, offset) decomposition once and derive subsequent offsets from
+  // the raw encoding for as long as the locations stay inside the same
+  // file's extent.
+  FileID CurFile;
+  unsigned CurFileBase = 0; // Raw encoding of the start of CurFile.
+  unsigned CurFileSize = 0;
+
+  for (unsigned I = 0; I != NumTokens; ++I) {
+    SourceLocation Loc =
+        SourceLocation::getFromRawEncoding(Tokens[I].int_data[1]);
+    unsigned Raw = Loc.getRawEncoding();
+    if (CurFile.isInvalid() || Raw < CurFileBase ||
+        Raw - CurFileBase >= CurFileSize) {
+      std::pair<FileID, unsigned> LocInfo = SM.getDecomposedSpellingLoc(Loc);
+      CurFile = LocInfo.first;
+      CurFileBase = Raw - LocInfo.second;
+      bool Invalid = false;
+      CurFileSize = SM.getBufferData(CurFile, &Invalid).size();
+      if (Invalid)
+        CurFileSize = 0;
+    }
+    Records[I].offset = Raw - CurFileBase;
+    Records[I].length = Tokens[I].int_data[2];
+    Records[I].kind = Tokens[I].int_data[0];
+  }
+}
+
 static void getTokens(ASTUnit *CXXUnit, SourceRange Range,
                       SmallVectorImpl<CXToken> &CXTokens) {
   SourceManager &SourceMgr = CXXUnit->getSourceManager();
@@ -0,0 +1,108 @@
+//===- unittests/Lex/DependencyDirectivesSourceMinimizerTest.cpp ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/DependencyDirectivesSourceMinimizer.h"
+#include "llvm/ADT/SmallString.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+
+namespace {
+
+static std::string minimize(llvm::StringRef Input) {
+  llvm::SmallVector<char, 128> Out;
+  EXPECT_FALSE(minimizeSourceToDependencyDirectives(Input, Out));
+  return std::string(Out.begin(), Out.end());
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, Empty) {
+  EXPECT_EQ("", minimize(""));
+  EXPECT_EQ("", minimize("int x;\nvoid f() {}\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, KeepsDirectivesDropsCode) {
+  EXPECT_EQ("#include <a.h>\n#define A 1\n",
+            minimize("#include <a.h>\n"
+                     "int x;\n"
+                     "#define A 1\n"
+                     "void f() {}\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, LeadingWhitespaceAndComments) {
+  EXPECT_EQ("#include <a.h>\n", minimize("   \t #include <a.h>\n"));
+  EXPECT_EQ("#include <a.h>\n", minimize("/* c */ #include <a.h>\n"));
+  EXPECT_EQ("#include <a.h>\n", minimize("/* multi\nline */ #include <a.h>\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, LineContinuations) {
+  EXPECT_EQ("#define A \\\n  1\n",
+            minimize("#define A \\\n"
+                     "  1\n"
+                     "int x;\n"));
+  // A '#' on the continuation of a non-directive line is not a directive.
+  EXPECT_EQ("#define REAL\n",
+            minimize("int x = 1 + \\\n"
+                     "#define NOT_A_DIRECTIVE\n"
+                     "2;\n"
+                     "#define REAL\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, CommentsHideDirectives) {
+  EXPECT_EQ("#define VISIBLE\n",
+            minimize("/*\n"
+                     "#define HIDDEN\n"
+                     "*/\n"
+                     "#define VISIBLE\n"));
+  EXPECT_EQ("", minimize("// #define HIDDEN\n"));
+  // An escaped newline continues a line comment.
+  EXPECT_EQ("", minimize("// hides \\\n"
+                         "#define HIDDEN\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, LiteralsHideDirectives) {
+  EXPECT_EQ("#define AFTER\n",
+            minimize("const char *S = R\"(\n"
+                     "#define INSIDE\n"
+                     ")\";\n"
+                     "#define AFTER\n"));
+  EXPECT_EQ("#define AFTER\n",
+            minimize("const char *S = R\"x(\n"
+                     "#define INSIDE\n"
+                     ")x\";\n"
+                     "#define AFTER\n"));
+  // "/*" inside a plain string must not open a comment.
+  EXPECT_EQ("#define B\n",
+            minimize("const char *S = \"/*\";\n"
+                     "#define B\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, HeaderNames) {
+  // "//" inside an angle header-name is not a comment.
+  EXPECT_EQ("#include <a//b.h>\n", minimize("#include <a//b.h>\n"));
+  EXPECT_EQ("#include \"a//b.h\"\n", minimize("#include \"a//b.h\"\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, UnbalancedQuoteInDirective) {
+  EXPECT_EQ("#error don't panic\n#define A\n",
+            minimize("#error don't panic\n"
+                     "#define A\n"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, MissingFinalNewline) {
+  EXPECT_EQ("#define A 1\n", minimize("#define A 1"));
+}
+
+TEST(MinimizeSourceToDependencyDirectivesTest, UnterminatedConstructs) {
+  llvm::SmallVector<char, 128> Out;
+  EXPECT_TRUE(minimizeSourceToDependencyDirectives("/* oops", Out));
+  EXPECT_TRUE(minimizeSourceToDependencyDirectives(
+      "const char *S = R\"(oops\n#define A\n", Out));
+}
+
+} // end anonymous namespace
@@ -912,6 +912,31 @@ TEST(Range, ConflictingRangesBeforeReplacements) {
   EXPECT_EQ(Expected, calculateRangesAfterReplacements(Replaces, Ranges));
 }
 
+TEST(ApplyAllReplacementsTest, StreamingMatchesStringApplication) {
+  StringRef Code = "int foo;\nint bar;\n";
+  Replacements Replaces = toReplacements(
+      {Replacement("foo", 4, 3, "x"), Replacement("foo", 13, 3, "y")});
+  auto Expected = applyAllReplacements(Code, Replaces);
+  ASSERT_TRUE(static_cast<bool>(Expected));
+
+  std::string Streamed;
+  llvm::raw_string_ostream OS(Streamed);
+  llvm::Error Err = applyAllReplacements(Code, Replaces, OS);
+  EXPECT_FALSE(static_cast<bool>(Err));
+  EXPECT_EQ(*Expected, OS.str());
+}
+
+TEST(ApplyAllReplacementsTest, StreamingFailsOnInvalidOffset) {
+  StringRef Code = "int foo;\n";
+  Replacements Replaces = toReplacements({Replacement("foo", 100, 1, "x")});
+
+  std::string Streamed;
+  llvm::raw_string_ostream OS(Streamed);
+  llvm::Error Err = applyAllReplacements(Code, Replaces, OS);
+  EXPECT_TRUE(static_cast<bool>(Err));
+  llvm::consumeError(std::move(Err));
+}
+
 class MergeReplacementsTest : public ::testing::Test {
 protected:
   void mergeAndTestRewrite(StringRef Code, StringRef Intermediate,